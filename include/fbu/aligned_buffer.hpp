@@ -0,0 +1,189 @@
+#ifndef FBU_ALIGNED_BUFFER_HPP_INCLUDED
+#define FBU_ALIGNED_BUFFER_HPP_INCLUDED
+
+/**
+ @file aligned_buffer.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ @class AlignedBuffer
+ @brief Fixed-size array of T whose first element is aligned on ALIGNMENT
+ bytes, for SIMD loads and stores.
+
+ The storage is over-allocated and the aligned pointer computed by hand, which
+ does not require C++17 aligned new, hence the restriction to trivial types.
+ The elements are zero-initialized.
+ */
+template <typename T, size_t ALIGNMENT = 64>
+class AlignedBuffer
+{
+    static_assert((ALIGNMENT & (ALIGNMENT - 1)) == 0, "The alignment must be a power of 2");
+    static_assert(std::is_trivial<T>::value, "AlignedBuffer only holds trivial types");
+
+public:
+    static constexpr size_t kAlignment = ALIGNMENT;
+
+    explicit AlignedBuffer(size_t pSize = 0)
+    {
+        allocate(pSize);
+    }
+
+    AlignedBuffer(const AlignedBuffer& pOther)
+    {
+        allocate(pOther.mSize);
+        std::copy(pOther.begin(), pOther.end(), begin());
+    }
+
+    AlignedBuffer(AlignedBuffer&& pOther)
+    : mStorage(std::move(pOther.mStorage))
+    , mData(pOther.mData)
+    , mSize(pOther.mSize)
+    {
+        pOther.mData = nullptr;
+        pOther.mSize = 0;
+    }
+
+    AlignedBuffer& operator=(const AlignedBuffer& pOther)
+    {
+        if (this != &pOther)
+        {
+            if (mSize != pOther.mSize)
+            {
+                allocate(pOther.mSize);
+            }
+            std::copy(pOther.begin(), pOther.end(), begin());
+        }
+        return *this;
+    }
+
+    AlignedBuffer& operator=(AlignedBuffer&& pOther)
+    {
+        mStorage = std::move(pOther.mStorage);
+        mData = pOther.mData;
+        mSize = pOther.mSize;
+        pOther.mData = nullptr;
+        pOther.mSize = 0;
+        return *this;
+    }
+
+    /**
+     Reallocate: the previous content is lost and the elements are
+     zero-initialized.
+     */
+    void resize(size_t pSize)
+    {
+        allocate(pSize);
+    }
+
+    void clear()
+    {
+        std::fill(begin(), end(), T());
+    }
+
+    size_t size() const
+    {
+        return mSize;
+    }
+
+    T* data()
+    {
+        return mData;
+    }
+
+    const T* data() const
+    {
+        return mData;
+    }
+
+    T* begin()
+    {
+        return mData;
+    }
+
+    const T* begin() const
+    {
+        return mData;
+    }
+
+    T* end()
+    {
+        return mData + mSize;
+    }
+
+    const T* end() const
+    {
+        return mData + mSize;
+    }
+
+    T& operator[](size_t pIndex)
+    {
+        assert(pIndex < mSize);
+        return mData[pIndex];
+    }
+
+    const T& operator[](size_t pIndex) const
+    {
+        assert(pIndex < mSize);
+        return mData[pIndex];
+    }
+
+private:
+    void allocate(size_t pSize)
+    {
+        mStorage.reset();
+        mData = nullptr;
+        mSize = pSize;
+        if (pSize != 0)
+        {
+            mStorage.reset(new unsigned char[pSize * sizeof(T) + ALIGNMENT]);
+            uintptr_t lAddress = reinterpret_cast<uintptr_t>(mStorage.get());
+            uintptr_t lAligned = (lAddress + (ALIGNMENT - 1)) & ~(uintptr_t)(ALIGNMENT - 1);
+            mData = reinterpret_cast<T*>(lAligned);
+            std::fill(mData, mData + pSize, T());
+        }
+    }
+
+    std::unique_ptr<unsigned char[]> mStorage;
+    T*                               mData = nullptr;
+    size_t                           mSize = 0;
+};
+
+template <typename T, size_t ALIGNMENT> constexpr size_t AlignedBuffer<T, ALIGNMENT>::kAlignment;
+
+}
+
+#endif
@@ -127,7 +127,7 @@ struct Complex
     
     Complex<T>& operator/=(const T& s)
     {
-        float sinv = ((T)1) / s;
+        T sinv = ((T)1) / s;
         re *= sinv;
         im *= sinv;
         return *this;
@@ -135,9 +135,12 @@ struct Complex
     
     Complex<T>& operator/=(const Complex<T>& a)
     {
-        Complex<T> ainv = a.inverse();
-        *this = *this * ainv;
-        *this = *this * ainv;
+        // a single reciprocal: this * conj(a) / |a|^2
+        T lScale = ((T)1) / a.sqrmag();
+        T lRe = (re * a.re + im * a.im) * lScale;
+        T lIm = (im * a.re - re * a.im) * lScale;
+        re = lRe;
+        im = lIm;
         return *this;
     }
     
@@ -0,0 +1,538 @@
+#ifndef FBU_COMPLEX_VECT_HPP_INCLUDED
+#define FBU_COMPLEX_VECT_HPP_INCLUDED
+
+/**
+ @file complex_vect.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/complex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+// The SSE kernels are selected at compile time, like the denormals handling:
+// SSE2 is part of the x86-64 baseline. On top of them, with GCC and Clang on
+// x86, the element-wise kernels dispatch at runtime to AVX+FMA versions when
+// the CPU (and OS) support them; the check is done once and cached.
+// Define FBU_COMPLEX_VECT_USE_SSE to 0 to force the portable loops, or
+// FBU_COMPLEX_VECT_USE_AVX to 0 to stay on SSE.
+#if !defined(FBU_COMPLEX_VECT_USE_SSE)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FBU_COMPLEX_VECT_USE_SSE 1
+#else
+#define FBU_COMPLEX_VECT_USE_SSE 0
+#endif
+#endif
+
+#if !defined(FBU_COMPLEX_VECT_USE_AVX)
+#if FBU_COMPLEX_VECT_USE_SSE && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FBU_COMPLEX_VECT_USE_AVX 1
+#else
+#define FBU_COMPLEX_VECT_USE_AVX 0
+#endif
+#endif
+
+#if FBU_COMPLEX_VECT_USE_SSE
+#include <emmintrin.h>
+#endif
+
+#if FBU_COMPLEX_VECT_USE_AVX
+#include <immintrin.h>
+#endif
+
+//==============================================================================
+// Element-wise kernels over interleaved Complex<T> arrays. The output may be
+// the same array as one of the inputs, but must not partially overlap them.
+
+/**
+ out = a * b
+ */
+template<typename T>
+void vectMultiply(const Complex<T>* pA, const Complex<T>* pB, Complex<T>* pOut, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pOut[u] = pA[u] * pB[u];
+    }
+}
+
+/**
+ acc += a * b
+ */
+template<typename T>
+void vectMultiplyAccumulate(const Complex<T>* pA, const Complex<T>* pB, Complex<T>* pAcc, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pAcc[u].re += pA[u].re * pB[u].re - pA[u].im * pB[u].im;
+        pAcc[u].im += pA[u].im * pB[u].re + pA[u].re * pB[u].im;
+    }
+}
+
+/**
+ acc += a * conj(b)
+ */
+template<typename T>
+void vectConjMultiplyAccumulate(const Complex<T>* pA, const Complex<T>* pB, Complex<T>* pAcc, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pAcc[u].re += pA[u].re * pB[u].re + pA[u].im * pB[u].im;
+        pAcc[u].im += pA[u].im * pB[u].re - pA[u].re * pB[u].im;
+    }
+}
+
+/**
+ inOut += s * in
+ */
+template<typename T>
+void vectScaleAdd(T pS, const Complex<T>* pIn, Complex<T>* pInOut, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pInOut[u].re += pS * pIn[u].re;
+        pInOut[u].im += pS * pIn[u].im;
+    }
+}
+
+/**
+ out = a / b, regularized: a * conj(b) / (|b|^2 + epsilon), so that bins
+ where b vanishes go to zero instead of blowing up (deconvolution, transfer
+ function estimation).
+ */
+template<typename T>
+void vectDivideRegularized(const Complex<T>* pA, const Complex<T>* pB, T pEpsilon, Complex<T>* pOut, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        T lScale = (T)1 / (pB[u].sqrmag() + pEpsilon);
+        pOut[u] = lScale * (pA[u] * pB[u].conj());
+    }
+}
+
+//==============================================================================
+// Polar kernels. The fast variants trade accuracy for branchless polynomial
+// approximations that vectorize (float only).
+
+template<typename T>
+void vectSqrMagnitude(const Complex<T>* __restrict pIn, T* __restrict pOut, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pOut[u] = pIn[u].re * pIn[u].re + pIn[u].im * pIn[u].im;
+    }
+}
+
+/**
+ sqrt(re^2 + im^2): unlike Complex<T>::mag() there is no overflow protection.
+ */
+template<typename T>
+void vectMagnitude(const Complex<T>* __restrict pIn, T* __restrict pOut, size_t pSize)
+{
+    vectSqrMagnitude(pIn, pOut, pSize);
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pOut[u] = std::sqrt(pOut[u]);
+    }
+}
+
+/**
+ Magnitude in dB, limited to pMinDB below.
+ */
+template<typename T>
+void vectMagnitudeDB(const Complex<T>* __restrict pIn, T* __restrict pOut, size_t pSize, T pMinDB = (T)(-144))
+{
+    const T lMinSqrMagnitude = std::pow((T)10, pMinDB / (T)10);
+    vectSqrMagnitude(pIn, pOut, pSize);
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pOut[u] = (T)10 * std::log10(std::max(pOut[u], lMinSqrMagnitude));
+    }
+}
+
+inline void vectFastMagnitudeDB(const Complex<float>* __restrict pIn, float* __restrict pOut, size_t pSize, float pMinDB = -144.f)
+{
+    const float lMinSqrMagnitude = std::pow(10.f, pMinDB / 10.f);
+    vectSqrMagnitude(pIn, pOut, pSize);
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pOut[u] = mu::fast_powToDB(std::max(pOut[u], lMinSqrMagnitude));
+    }
+}
+
+/**
+ Phase in )-π,π).
+ */
+template<typename T>
+void vectPhase(const Complex<T>* __restrict pIn, T* __restrict pOut, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pOut[u] = std::atan2(pIn[u].im, pIn[u].re);
+    }
+}
+
+inline void vectFastPhase(const Complex<float>* __restrict pIn, float* __restrict pOut, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pOut[u] = mu::fast_atan2(pIn[u].im, pIn[u].re);
+    }
+}
+
+template<typename T>
+void vectPolarToRect(const T* __restrict pMagnitudes, const T* __restrict pPhases, Complex<T>* __restrict pOut, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pOut[u].re = pMagnitudes[u] * std::cos(pPhases[u]);
+        pOut[u].im = pMagnitudes[u] * std::sin(pPhases[u]);
+    }
+}
+
+/**
+ Like Complex<float>::fastPolar(): the phases can be any angle, they are
+ wrapped to )-π,π) without branches before the polynomial approximations.
+ */
+inline void vectFastPolarToRect(const float* __restrict pMagnitudes, const float* __restrict pPhases, Complex<float>* __restrict pOut, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        float lPhase = pPhases[u] - 2.f * M_PIf * std::floor(pPhases[u] * (0.5f * M_1_PIf) + 0.5f);
+        pOut[u].re = pMagnitudes[u] * mu::fastCos8(lPhase);
+        pOut[u].im = pMagnitudes[u] * mu::fastSin9(lPhase);
+    }
+}
+
+#if FBU_COMPLEX_VECT_USE_AVX
+
+//==============================================================================
+// AVX+FMA kernels: four Complex<float> or two Complex<double> per register.
+// With b.re and b.im duplicated over each complex, a * b is
+// fmaddsub(a, b.re, swap(a) * b.im) and a * conj(b) the same with fmsubadd.
+// Each kernel only processes whole registers and returns the number of
+// elements done; the overloads below finish the remainder.
+
+#define FBU_COMPLEX_VECT_AVX_TARGET __attribute__((target("avx,fma")))
+
+namespace fbu_complex_vect_avx
+{
+    inline bool isSupported()
+    {
+        static const bool lSupported = __builtin_cpu_supports("avx") && __builtin_cpu_supports("fma");
+        return lSupported;
+    }
+    
+    // a * b, or a * conj(b) with pConj
+    FBU_COMPLEX_VECT_AVX_TARGET inline __m256 multiply(__m256 a, __m256 b, bool pConj)
+    {
+        __m256 lASwapBIm = _mm256_mul_ps(_mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1)), _mm256_movehdup_ps(b));
+        __m256 lBRe = _mm256_moveldup_ps(b);
+        return pConj ? _mm256_fmsubadd_ps(a, lBRe, lASwapBIm) : _mm256_fmaddsub_ps(a, lBRe, lASwapBIm);
+    }
+    
+    FBU_COMPLEX_VECT_AVX_TARGET inline __m256d multiply(__m256d a, __m256d b, bool pConj)
+    {
+        __m256d lASwapBIm = _mm256_mul_pd(_mm256_permute_pd(a, 0x5), _mm256_permute_pd(b, 0xF));
+        __m256d lBRe = _mm256_movedup_pd(b);
+        return pConj ? _mm256_fmsubadd_pd(a, lBRe, lASwapBIm) : _mm256_fmaddsub_pd(a, lBRe, lASwapBIm);
+    }
+    
+    // |b|^2 + epsilon, in both lanes of each complex
+    FBU_COMPLEX_VECT_AVX_TARGET inline __m256 sqrMagnitude(__m256 b, __m256 pEpsilon)
+    {
+        __m256 lSquares = _mm256_mul_ps(b, b);
+        return _mm256_add_ps(_mm256_add_ps(lSquares, _mm256_permute_ps(lSquares, _MM_SHUFFLE(2, 3, 0, 1))), pEpsilon);
+    }
+    
+    FBU_COMPLEX_VECT_AVX_TARGET inline __m256d sqrMagnitude(__m256d b, __m256d pEpsilon)
+    {
+        __m256d lSquares = _mm256_mul_pd(b, b);
+        return _mm256_add_pd(_mm256_add_pd(lSquares, _mm256_permute_pd(lSquares, 0x5)), pEpsilon);
+    }
+    
+    FBU_COMPLEX_VECT_AVX_TARGET inline __m256 load(const Complex<float>* p) { return _mm256_loadu_ps(reinterpret_cast<const float*>(p)); }
+    FBU_COMPLEX_VECT_AVX_TARGET inline __m256d load(const Complex<double>* p) { return _mm256_loadu_pd(reinterpret_cast<const double*>(p)); }
+    FBU_COMPLEX_VECT_AVX_TARGET inline void store(Complex<float>* p, __m256 v) { _mm256_storeu_ps(reinterpret_cast<float*>(p), v); }
+    FBU_COMPLEX_VECT_AVX_TARGET inline void store(Complex<double>* p, __m256d v) { _mm256_storeu_pd(reinterpret_cast<double*>(p), v); }
+    FBU_COMPLEX_VECT_AVX_TARGET inline __m256 broadcast(float s) { return _mm256_set1_ps(s); }
+    FBU_COMPLEX_VECT_AVX_TARGET inline __m256d broadcast(double s) { return _mm256_set1_pd(s); }
+    FBU_COMPLEX_VECT_AVX_TARGET inline __m256 add(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+    FBU_COMPLEX_VECT_AVX_TARGET inline __m256d add(__m256d a, __m256d b) { return _mm256_add_pd(a, b); }
+    FBU_COMPLEX_VECT_AVX_TARGET inline __m256 fmadd(__m256 a, __m256 b, __m256 c) { return _mm256_fmadd_ps(a, b, c); }
+    FBU_COMPLEX_VECT_AVX_TARGET inline __m256d fmadd(__m256d a, __m256d b, __m256d c) { return _mm256_fmadd_pd(a, b, c); }
+    FBU_COMPLEX_VECT_AVX_TARGET inline __m256 divide(__m256 a, __m256 b) { return _mm256_div_ps(a, b); }
+    FBU_COMPLEX_VECT_AVX_TARGET inline __m256d divide(__m256d a, __m256d b) { return _mm256_div_pd(a, b); }
+    
+    template<typename T>
+    FBU_COMPLEX_VECT_AVX_TARGET size_t vectMultiply(const Complex<T>* pA, const Complex<T>* pB, Complex<T>* pOut, size_t pSize)
+    {
+        const size_t lStep = 32 / sizeof(Complex<T>);
+        size_t u = 0;
+        for ( ; u + lStep <= pSize ; u += lStep)
+        {
+            store(pOut + u, multiply(load(pA + u), load(pB + u), false));
+        }
+        return u;
+    }
+    
+    template<typename T>
+    FBU_COMPLEX_VECT_AVX_TARGET size_t vectMultiplyAccumulate(const Complex<T>* pA, const Complex<T>* pB, Complex<T>* pAcc, size_t pSize, bool pConj)
+    {
+        const size_t lStep = 32 / sizeof(Complex<T>);
+        size_t u = 0;
+        for ( ; u + lStep <= pSize ; u += lStep)
+        {
+            store(pAcc + u, add(load(pAcc + u), multiply(load(pA + u), load(pB + u), pConj)));
+        }
+        return u;
+    }
+    
+    template<typename T>
+    FBU_COMPLEX_VECT_AVX_TARGET size_t vectScaleAdd(T pS, const Complex<T>* pIn, Complex<T>* pInOut, size_t pSize)
+    {
+        const size_t lStep = 32 / sizeof(Complex<T>);
+        const auto lS = broadcast(pS);
+        size_t u = 0;
+        for ( ; u + lStep <= pSize ; u += lStep)
+        {
+            store(pInOut + u, fmadd(lS, load(pIn + u), load(pInOut + u)));
+        }
+        return u;
+    }
+    
+    template<typename T>
+    FBU_COMPLEX_VECT_AVX_TARGET size_t vectDivideRegularized(const Complex<T>* pA, const Complex<T>* pB, T pEpsilon, Complex<T>* pOut, size_t pSize)
+    {
+        const size_t lStep = 32 / sizeof(Complex<T>);
+        const auto lEpsilon = broadcast(pEpsilon);
+        size_t u = 0;
+        for ( ; u + lStep <= pSize ; u += lStep)
+        {
+            const auto b = load(pB + u);
+            store(pOut + u, divide(multiply(load(pA + u), b, true), sqrMagnitude(b, lEpsilon)));
+        }
+        return u;
+    }
+}
+
+// Complex<double> only has the AVX path: one complex per SSE register is no
+// faster than the portable loops.
+
+inline void vectMultiply(const Complex<double>* pA, const Complex<double>* pB, Complex<double>* pOut, size_t pSize)
+{
+    size_t u = fbu_complex_vect_avx::isSupported() ? fbu_complex_vect_avx::vectMultiply(pA, pB, pOut, pSize) : 0;
+    vectMultiply<double>(pA + u, pB + u, pOut + u, pSize - u);
+}
+
+inline void vectMultiplyAccumulate(const Complex<double>* pA, const Complex<double>* pB, Complex<double>* pAcc, size_t pSize)
+{
+    size_t u = fbu_complex_vect_avx::isSupported() ? fbu_complex_vect_avx::vectMultiplyAccumulate(pA, pB, pAcc, pSize, false) : 0;
+    vectMultiplyAccumulate<double>(pA + u, pB + u, pAcc + u, pSize - u);
+}
+
+inline void vectConjMultiplyAccumulate(const Complex<double>* pA, const Complex<double>* pB, Complex<double>* pAcc, size_t pSize)
+{
+    size_t u = fbu_complex_vect_avx::isSupported() ? fbu_complex_vect_avx::vectMultiplyAccumulate(pA, pB, pAcc, pSize, true) : 0;
+    vectConjMultiplyAccumulate<double>(pA + u, pB + u, pAcc + u, pSize - u);
+}
+
+inline void vectScaleAdd(double pS, const Complex<double>* pIn, Complex<double>* pInOut, size_t pSize)
+{
+    size_t u = fbu_complex_vect_avx::isSupported() ? fbu_complex_vect_avx::vectScaleAdd(pS, pIn, pInOut, pSize) : 0;
+    vectScaleAdd<double>(pS, pIn + u, pInOut + u, pSize - u);
+}
+
+inline void vectDivideRegularized(const Complex<double>* pA, const Complex<double>* pB, double pEpsilon, Complex<double>* pOut, size_t pSize)
+{
+    size_t u = fbu_complex_vect_avx::isSupported() ? fbu_complex_vect_avx::vectDivideRegularized(pA, pB, pEpsilon, pOut, pSize) : 0;
+    vectDivideRegularized<double>(pA + u, pB + u, pEpsilon, pOut + u, pSize - u);
+}
+
+#endif
+
+#if FBU_COMPLEX_VECT_USE_SSE
+
+//==============================================================================
+// SSE overloads: two Complex<float> per register, after the AVX kernels when
+// they are available. The products are computed as a * b.re + swap(a) * b.im,
+// with the sign of one lane flipped, so the only shuffles are the broadcasts
+// of b.re and b.im. The magnitudes gather four squared values from two
+// registers with two shuffles.
+
+namespace fbu_complex_vect_sse
+{
+    // a * b, or a * conj(b) with pConj
+    inline __m128 multiply(__m128 a, __m128 b, bool pConj)
+    {
+        const __m128 lSign = pConj ? _mm_set_ps(-0.f, 0.f, -0.f, 0.f) : _mm_set_ps(0.f, -0.f, 0.f, -0.f);
+        __m128 lBRe = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 lBIm = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 lASwap = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+        return _mm_add_ps(_mm_mul_ps(a, lBRe), _mm_xor_ps(_mm_mul_ps(lASwap, lBIm), lSign));
+    }
+
+    // |b|^2 + epsilon, in both lanes of each complex
+    inline __m128 sqrMagnitude(__m128 b, __m128 pEpsilon)
+    {
+        __m128 lSquares = _mm_mul_ps(b, b);
+        return _mm_add_ps(_mm_add_ps(lSquares, _mm_shuffle_ps(lSquares, lSquares, _MM_SHUFFLE(2, 3, 0, 1))), pEpsilon);
+    }
+
+    // |a0|^2, |a1|^2, |b0|^2, |b1|^2
+    inline __m128 sqrMagnitude4(__m128 a, __m128 b)
+    {
+        __m128 lSquaresA = _mm_mul_ps(a, a);
+        __m128 lSquaresB = _mm_mul_ps(b, b);
+        return _mm_add_ps(_mm_shuffle_ps(lSquaresA, lSquaresB, _MM_SHUFFLE(2, 0, 2, 0)),
+                          _mm_shuffle_ps(lSquaresA, lSquaresB, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+
+    inline __m128 load(const Complex<float>* p)
+    {
+        return _mm_loadu_ps(reinterpret_cast<const float*>(p));
+    }
+
+    inline void store(Complex<float>* p, __m128 v)
+    {
+        _mm_storeu_ps(reinterpret_cast<float*>(p), v);
+    }
+}
+
+inline void vectSqrMagnitude(const Complex<float>* __restrict pIn, float* __restrict pOut, size_t pSize)
+{
+    using namespace fbu_complex_vect_sse;
+    size_t u = 0;
+    for ( ; u + 4 <= pSize ; u += 4)
+    {
+        _mm_storeu_ps(pOut + u, sqrMagnitude4(load(pIn + u), load(pIn + u + 2)));
+    }
+    vectSqrMagnitude<float>(pIn + u, pOut + u, pSize - u);
+}
+
+inline void vectMagnitude(const Complex<float>* __restrict pIn, float* __restrict pOut, size_t pSize)
+{
+    using namespace fbu_complex_vect_sse;
+    size_t u = 0;
+    for ( ; u + 4 <= pSize ; u += 4)
+    {
+        _mm_storeu_ps(pOut + u, _mm_sqrt_ps(sqrMagnitude4(load(pIn + u), load(pIn + u + 2))));
+    }
+    vectMagnitude<float>(pIn + u, pOut + u, pSize - u);
+}
+
+inline void vectMultiply(const Complex<float>* pA, const Complex<float>* pB, Complex<float>* pOut, size_t pSize)
+{
+    using namespace fbu_complex_vect_sse;
+    size_t u = 0;
+#if FBU_COMPLEX_VECT_USE_AVX
+    if (fbu_complex_vect_avx::isSupported())
+    {
+        u = fbu_complex_vect_avx::vectMultiply(pA, pB, pOut, pSize);
+    }
+#endif
+    for ( ; u + 2 <= pSize ; u += 2)
+    {
+        store(pOut + u, multiply(load(pA + u), load(pB + u), false));
+    }
+    vectMultiply<float>(pA + u, pB + u, pOut + u, pSize - u);
+}
+
+inline void vectMultiplyAccumulate(const Complex<float>* pA, const Complex<float>* pB, Complex<float>* pAcc, size_t pSize)
+{
+    using namespace fbu_complex_vect_sse;
+    size_t u = 0;
+#if FBU_COMPLEX_VECT_USE_AVX
+    if (fbu_complex_vect_avx::isSupported())
+    {
+        u = fbu_complex_vect_avx::vectMultiplyAccumulate(pA, pB, pAcc, pSize, false);
+    }
+#endif
+    for ( ; u + 2 <= pSize ; u += 2)
+    {
+        store(pAcc + u, _mm_add_ps(load(pAcc + u), multiply(load(pA + u), load(pB + u), false)));
+    }
+    vectMultiplyAccumulate<float>(pA + u, pB + u, pAcc + u, pSize - u);
+}
+
+inline void vectConjMultiplyAccumulate(const Complex<float>* pA, const Complex<float>* pB, Complex<float>* pAcc, size_t pSize)
+{
+    using namespace fbu_complex_vect_sse;
+    size_t u = 0;
+#if FBU_COMPLEX_VECT_USE_AVX
+    if (fbu_complex_vect_avx::isSupported())
+    {
+        u = fbu_complex_vect_avx::vectMultiplyAccumulate(pA, pB, pAcc, pSize, true);
+    }
+#endif
+    for ( ; u + 2 <= pSize ; u += 2)
+    {
+        store(pAcc + u, _mm_add_ps(load(pAcc + u), multiply(load(pA + u), load(pB + u), true)));
+    }
+    vectConjMultiplyAccumulate<float>(pA + u, pB + u, pAcc + u, pSize - u);
+}
+
+inline void vectScaleAdd(float pS, const Complex<float>* pIn, Complex<float>* pInOut, size_t pSize)
+{
+    using namespace fbu_complex_vect_sse;
+    const __m128 lS = _mm_set1_ps(pS);
+    size_t u = 0;
+#if FBU_COMPLEX_VECT_USE_AVX
+    if (fbu_complex_vect_avx::isSupported())
+    {
+        u = fbu_complex_vect_avx::vectScaleAdd(pS, pIn, pInOut, pSize);
+    }
+#endif
+    for ( ; u + 2 <= pSize ; u += 2)
+    {
+        store(pInOut + u, _mm_add_ps(load(pInOut + u), _mm_mul_ps(lS, load(pIn + u))));
+    }
+    vectScaleAdd<float>(pS, pIn + u, pInOut + u, pSize - u);
+}
+
+inline void vectDivideRegularized(const Complex<float>* pA, const Complex<float>* pB, float pEpsilon, Complex<float>* pOut, size_t pSize)
+{
+    using namespace fbu_complex_vect_sse;
+    const __m128 lEpsilon = _mm_set1_ps(pEpsilon);
+    size_t u = 0;
+#if FBU_COMPLEX_VECT_USE_AVX
+    if (fbu_complex_vect_avx::isSupported())
+    {
+        u = fbu_complex_vect_avx::vectDivideRegularized(pA, pB, pEpsilon, pOut, pSize);
+    }
+#endif
+    for ( ; u + 2 <= pSize ; u += 2)
+    {
+        __m128 b = load(pB + u);
+        store(pOut + u, _mm_div_ps(multiply(load(pA + u), b, true), sqrMagnitude(b, lEpsilon)));
+    }
+    vectDivideRegularized<float>(pA + u, pB + u, pEpsilon, pOut + u, pSize - u);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,504 @@
+#ifndef FBU_CONVOLUTION_HPP_INCLUDED
+#define FBU_CONVOLUTION_HPP_INCLUDED
+
+/**
+ @file convolution.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/complex_vect.hpp"
+#include "fbu/fft.hpp"
+#include "fbu/thread_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ @class ConvolutionIR
+ @brief Impulse response preprocessed for uniformly partitioned convolution:
+ the spectra of its zero-padded partitions of pBlockSize samples.
+
+ It is immutable once built, so a single instance can be shared by all the
+ channels and convolvers that use the same IR.
+ */
+template <typename T>
+class ConvolutionIR
+{
+public:
+    /**
+     @param pIR The impulse response.
+     @param pLength Its length in samples.
+     @param pBlockSize The partition size, a power of 2.
+     */
+    ConvolutionIR(const T* pIR, size_t pLength, size_t pBlockSize)
+    : mLength(pLength)
+    , mBlockSize(pBlockSize)
+    , mNumPartitions(std::max((pLength + pBlockSize - 1) / pBlockSize, (size_t)1))
+    , mFFT(RealFFT<T>::get(2 * pBlockSize))
+    {
+        assert(pBlockSize != 0 && (pBlockSize & (pBlockSize - 1)) == 0);
+        const size_t lNumBins = getNumBins();
+        mSpectra.resize(mNumPartitions * lNumBins);
+        std::vector<T> lPadded(2 * pBlockSize);
+        for (size_t p = 0 ; p != mNumPartitions ; ++p)
+        {
+            size_t lStart = std::min(p * pBlockSize, pLength);
+            size_t lEnd = std::min(lStart + pBlockSize, pLength);
+            std::fill(lPadded.begin(), lPadded.end(), (T)0);
+            std::copy(pIR + lStart, pIR + lEnd, lPadded.begin());
+            mFFT->forward(lPadded.data(), mSpectra.data() + p * lNumBins);
+        }
+    }
+
+    size_t getLength() const
+    {
+        return mLength;
+    }
+
+    size_t getBlockSize() const
+    {
+        return mBlockSize;
+    }
+
+    size_t getNumPartitions() const
+    {
+        return mNumPartitions;
+    }
+
+    /**
+     The number of bins per partition: the FFT size is 2 * getBlockSize().
+     */
+    size_t getNumBins() const
+    {
+        return mBlockSize + 1;
+    }
+
+    const Complex<T>* getPartition(size_t pIndex) const
+    {
+        return mSpectra.data() + pIndex * getNumBins();
+    }
+
+    const RealFFT<T>& getFFT() const
+    {
+        return *mFFT;
+    }
+
+private:
+    size_t                                mLength;
+    size_t                                mBlockSize;
+    size_t                                mNumPartitions;
+    std::shared_ptr< const RealFFT<T> >   mFFT;
+    std::vector< Complex<T> >             mSpectra;
+};
+
+//==============================================================================
+/**
+ @class UniformConvolver
+ @brief Uniformly partitioned overlap-save convolution (UPOLS) of several
+ channels with one shared ConvolutionIR.
+
+ Each block of B input samples is transformed once (FFT size 2B) into a
+ frequency-domain delay line holding the spectra of the last P input blocks.
+ The output spectrum is the sum over p of FDL[p] * IR[p], computed with complex
+ multiply-accumulate kernels, and one inverse FFT gives the B output samples.
+
+ processBlock() has no latency: the output block already contains the
+ contribution of the input block. process() accepts any number of samples and
+ has a latency of B samples. Nothing is allocated after construction. The
+ channels share scratch buffers: process them from a single thread.
+ */
+template <typename T>
+class UniformConvolver
+{
+public:
+    UniformConvolver(std::shared_ptr< const ConvolutionIR<T> > pIR, int pNumChannels)
+    : mIR(std::move(pIR))
+    , mNumChannels(pNumChannels)
+    , mChannels((size_t)pNumChannels)
+    , mAccumulator(mIR->getNumBins())
+    , mTime(2 * mIR->getBlockSize())
+    {
+        const size_t lBlockSize = mIR->getBlockSize();
+        for (Channel& c : mChannels)
+        {
+            c.mInput.resize(2 * lBlockSize);
+            c.mFDL.resize(mIR->getNumPartitions() * mIR->getNumBins());
+            c.mFifoIn.resize(lBlockSize);
+            c.mFifoOut.resize(lBlockSize);
+        }
+        reset();
+    }
+
+    const ConvolutionIR<T>& getIR() const
+    {
+        return *mIR;
+    }
+
+    int getNumChannels() const
+    {
+        return mNumChannels;
+    }
+
+    size_t getBlockSize() const
+    {
+        return mIR->getBlockSize();
+    }
+
+    /**
+     The latency of process(), in samples.
+     */
+    size_t getLatency() const
+    {
+        return getBlockSize();
+    }
+
+    void reset()
+    {
+        for (Channel& c : mChannels)
+        {
+            std::fill(c.mInput.begin(), c.mInput.end(), (T)0);
+            std::fill(c.mFDL.begin(), c.mFDL.end(), Complex<T>({(T)0, (T)0}));
+            std::fill(c.mFifoIn.begin(), c.mFifoIn.end(), (T)0);
+            std::fill(c.mFifoOut.begin(), c.mFifoOut.end(), (T)0);
+            c.mFDLPosition = 0;
+            c.mFifoPosition = 0;
+        }
+    }
+
+    /**
+     Convolve exactly getBlockSize() samples of a channel. pIn and pOut may be
+     the same buffer.
+     */
+    void processBlock(int pChannel, const T* pIn, T* pOut)
+    {
+        Channel& c = mChannels[(size_t)pChannel];
+        const size_t lBlockSize = getBlockSize();
+        const size_t lNumBins = mIR->getNumBins();
+        const size_t lNumPartitions = mIR->getNumPartitions();
+
+        // slide the input window and transform it into the newest FDL slot
+        std::copy(c.mInput.begin() + (std::ptrdiff_t)lBlockSize, c.mInput.end(), c.mInput.begin());
+        std::copy(pIn, pIn + lBlockSize, c.mInput.begin() + (std::ptrdiff_t)lBlockSize);
+        Complex<T>* lNewest = c.mFDL.data() + c.mFDLPosition * lNumBins;
+        mIR->getFFT().forward(c.mInput.data(), lNewest);
+
+        // the input block that arrived p blocks ago meets partition p
+        vectMultiply(lNewest, mIR->getPartition(0), mAccumulator.data(), lNumBins);
+        size_t lSlot = c.mFDLPosition;
+        for (size_t p = 1 ; p != lNumPartitions ; ++p)
+        {
+            lSlot = (lSlot == 0 ? lNumPartitions : lSlot) - 1;
+            vectMultiplyAccumulate(c.mFDL.data() + lSlot * lNumBins, mIR->getPartition(p), mAccumulator.data(), lNumBins);
+        }
+        c.mFDLPosition = c.mFDLPosition + 1 == lNumPartitions ? 0 : c.mFDLPosition + 1;
+
+        // overlap-save: the first half of the circular convolution is aliased
+        mIR->getFFT().inverse(mAccumulator.data(), mTime.data());
+        std::copy(mTime.begin() + (std::ptrdiff_t)lBlockSize, mTime.end(), pOut);
+    }
+
+    /**
+     Convolve any number of samples of a channel, with getLatency() samples
+     of latency. pIn and pOut may be the same buffer.
+     */
+    void process(int pChannel, const T* pIn, T* pOut, size_t pNumSamples)
+    {
+        Channel& c = mChannels[(size_t)pChannel];
+        const size_t lBlockSize = getBlockSize();
+        while (pNumSamples != 0)
+        {
+            size_t n = std::min(pNumSamples, lBlockSize - c.mFifoPosition);
+            for (size_t i = 0 ; i != n ; ++i)
+            {
+                T lIn = pIn[i];
+                pOut[i] = c.mFifoOut[c.mFifoPosition + i];
+                c.mFifoIn[c.mFifoPosition + i] = lIn;
+            }
+            c.mFifoPosition += n;
+            if (c.mFifoPosition == lBlockSize)
+            {
+                processBlock(pChannel, c.mFifoIn.data(), c.mFifoOut.data());
+                c.mFifoPosition = 0;
+            }
+            pIn += n;
+            pOut += n;
+            pNumSamples -= n;
+        }
+    }
+
+private:
+    struct Channel
+    {
+        std::vector<T>            mInput;
+        std::vector< Complex<T> > mFDL;
+        size_t                    mFDLPosition;
+        std::vector<T>            mFifoIn;
+        std::vector<T>            mFifoOut;
+        size_t                    mFifoPosition;
+    };
+
+    std::shared_ptr< const ConvolutionIR<T> > mIR;
+    int                                       mNumChannels;
+    std::vector<Channel>                      mChannels;
+    std::vector< Complex<T> >                 mAccumulator;
+    std::vector<T>                            mTime;
+};
+
+//==============================================================================
+/**
+ @class NonUniformConvolver
+ @brief Zero-latency convolution with long impulse responses: a small uniform
+ head on the audio thread, and progressively larger partitions computed in the
+ background on a ThreadPool.
+
+ With B the block size, the head is a UniformConvolver of block B covering
+ [0, 8B). Stage s >= 1 is a UniformConvolver of block P(s) = B.4^s covering
+ [2.P(s), 2.P(s+1)), the last stage going to the end of the IR. A stage
+ buffers P(s) input samples, then submits one job that convolves them; since
+ its segment starts 2.P(s) samples into the IR, the job has a whole period of
+ P(s) samples before its output is needed. The audio thread waits for a stage job
+ only at that deadline, right before submitting the next one.
+
+ Stage periods end together, as the sizes are multiples of each other: the
+ jobs are then submitted by increasing partition size, so that the earliest
+ deadline goes first through the FIFO of the ThreadPool. Without a ThreadPool
+ the jobs run synchronously, with the same output and CPU peaks.
+
+ This moves the CPU load of the tail off the audio thread, but the hand-off
+ itself is not strictly real-time safe: submitting goes through
+ ThreadPool::addJob(), which locks the queue mutex and pushes a std::function
+ (the capture fits in its small buffer, but the queue may grow), and the
+ deadline wait blocks on the JobCounter of the stage if the job is late, i.e.
+ if the pool is overloaded. Use a ThreadPool dedicated to the convolvers so
+ that the locks are only contended by their own jobs.
+ */
+template <typename T>
+class NonUniformConvolver
+{
+public:
+    /**
+     @param pIR The impulse response.
+     @param pLength Its length in samples.
+     @param pBlockSize The size of the blocks given to processBlock(), a power of 2.
+     @param pNumChannels The number of channels, all convolved with the IR.
+     @param pThreadPool The ThreadPool for the background partitions, or nullptr.
+     @param pMaxPartitionSize The largest partition size.
+     */
+    NonUniformConvolver(const T* pIR, size_t pLength, size_t pBlockSize, int pNumChannels,
+                        ThreadPool* pThreadPool = nullptr, size_t pMaxPartitionSize = 8192)
+    : mBlockSize(pBlockSize)
+    , mNumChannels(pNumChannels)
+    , mThreadPool(pThreadPool)
+    {
+        size_t lHeadEnd = std::min(pLength, 8 * pBlockSize);
+        size_t lPartitionSize = 4 * pBlockSize;
+        if (lPartitionSize > pMaxPartitionSize)
+        {
+            lHeadEnd = pLength;
+        }
+        mHead.reset(new UniformConvolver<T>(std::make_shared< const ConvolutionIR<T> >(pIR, lHeadEnd, pBlockSize), pNumChannels));
+        size_t lStart = lHeadEnd;
+        while (lStart < pLength)
+        {
+            bool lIsLast = 4 * lPartitionSize > pMaxPartitionSize;
+            size_t lEnd = lIsLast ? pLength : std::min(pLength, 8 * lPartitionSize);
+            auto lIR = std::make_shared< const ConvolutionIR<T> >(pIR + lStart, lEnd - lStart, lPartitionSize);
+            mStages.emplace_back(new Stage(std::move(lIR), pNumChannels));
+            lStart = lEnd;
+            lPartitionSize *= 4;
+        }
+    }
+
+    ~NonUniformConvolver()
+    {
+        waitForJobs();
+    }
+
+    size_t getBlockSize() const
+    {
+        return mBlockSize;
+    }
+
+    int getNumChannels() const
+    {
+        return mNumChannels;
+    }
+
+    /**
+     The number of background stages, not counting the head.
+     */
+    size_t getNumStages() const
+    {
+        return mStages.size();
+    }
+
+    size_t getStagePartitionSize(size_t pStage) const
+    {
+        return mStages[pStage]->mConvolver.getBlockSize();
+    }
+
+    void reset()
+    {
+        waitForJobs();
+        mHead->reset();
+        for (auto& lStage : mStages)
+        {
+            lStage->mConvolver.reset();
+            lStage->mPosition = 0;
+            for (int c = 0 ; c != mNumChannels ; ++c)
+            {
+                std::fill(lStage->mInputs[(size_t)c].begin(), lStage->mInputs[(size_t)c].end(), (T)0);
+                std::fill(lStage->mOutputs[(size_t)c].begin(), lStage->mOutputs[(size_t)c].end(), (T)0);
+                std::fill(lStage->mJobOutputs[(size_t)c].begin(), lStage->mJobOutputs[(size_t)c].end(), (T)0);
+            }
+        }
+    }
+
+    /**
+     Convolve exactly getBlockSize() samples of every channel, without latency.
+     pIn and pOut may be the same buffers.
+     */
+    void processBlock(const T* const* pIn, T* const* pOut)
+    {
+        for (auto& lStage : mStages)
+        {
+            for (int c = 0 ; c != mNumChannels ; ++c)
+            {
+                std::copy(pIn[c], pIn[c] + mBlockSize, lStage->mInputs[(size_t)c].begin() + (std::ptrdiff_t)lStage->mPosition);
+            }
+        }
+        for (int c = 0 ; c != mNumChannels ; ++c)
+        {
+            mHead->processBlock(c, pIn[c], pOut[c]);
+        }
+        for (auto& lStage : mStages)
+        {
+            for (int c = 0 ; c != mNumChannels ; ++c)
+            {
+                const T* lStageOutput = lStage->mOutputs[(size_t)c].data() + lStage->mPosition;
+                for (size_t i = 0 ; i != mBlockSize ; ++i)
+                {
+                    pOut[c][i] += lStageOutput[i];
+                }
+            }
+            lStage->mPosition += mBlockSize;
+        }
+        // stages are sorted by partition size: earliest deadline first
+        for (auto& lStage : mStages)
+        {
+            if (lStage->mPosition == lStage->mConvolver.getBlockSize())
+            {
+                lStage->mPosition = 0;
+                submit(*lStage);
+            }
+        }
+    }
+
+private:
+    struct Stage : public fbu::lang::NonCopyable
+    {
+        Stage(std::shared_ptr< const ConvolutionIR<T> > pIR, int pNumChannels)
+        : mConvolver(std::move(pIR), pNumChannels)
+        , mPosition(0)
+        {
+            const size_t lSize = mConvolver.getBlockSize();
+            for (int c = 0 ; c != pNumChannels ; ++c)
+            {
+                mInputs.emplace_back(lSize);
+                mJobInputs.emplace_back(lSize);
+                mOutputs.emplace_back(lSize);
+                mJobOutputs.emplace_back(lSize);
+            }
+        }
+
+        void run()
+        {
+            for (int c = 0 ; c != mConvolver.getNumChannels() ; ++c)
+            {
+                mConvolver.processBlock(c, mJobInputs[(size_t)c].data(), mJobOutputs[(size_t)c].data());
+            }
+        }
+
+        UniformConvolver<T>           mConvolver;
+        size_t                        mPosition;
+        // written by the audio thread
+        std::vector< std::vector<T> > mInputs;
+        std::vector< std::vector<T> > mOutputs;
+        // owned by the job while it runs
+        std::vector< std::vector<T> > mJobInputs;
+        std::vector< std::vector<T> > mJobOutputs;
+        JobCounter                    mJobs;
+    };
+
+    void submit(Stage& pStage)
+    {
+        // deadline of the previous job: its output is read from the next block
+        pStage.mJobs.waitForCompletion();
+        std::swap(pStage.mOutputs, pStage.mJobOutputs);
+        std::swap(pStage.mInputs, pStage.mJobInputs);
+        if (mThreadPool != nullptr)
+        {
+            Stage* lStage = &pStage;
+            lStage->mJobs.increment();
+            mThreadPool->addJob([lStage]{
+                lStage->run();
+                lStage->mJobs.decrement();
+            });
+        }
+        else
+        {
+            pStage.run();
+        }
+    }
+
+    void waitForJobs()
+    {
+        for (auto& lStage : mStages)
+        {
+            lStage->mJobs.waitForCompletion();
+        }
+    }
+
+    size_t                                       mBlockSize;
+    int                                          mNumChannels;
+    ThreadPool*                                  mThreadPool;
+    std::unique_ptr< UniformConvolver<T> >       mHead;
+    std::vector< std::unique_ptr<Stage> >        mStages;
+};
+
+typedef ConvolutionIR<float> ConvolutionIRf;
+typedef UniformConvolver<float> UniformConvolverf;
+typedef NonUniformConvolver<float> NonUniformConvolverf;
+
+}
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef FBU_CROSS_CORRELATION_HPP_INCLUDED
+#define FBU_CROSS_CORRELATION_HPP_INCLUDED
+
+/**
+ @file cross_correlation.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/complex_vect.hpp"
+#include "fbu/fft.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace fbu
+{
+
+enum class CrossCorrelationWeighting
+{
+    None,
+    PHAT
+};
+
+//==============================================================================
+/**
+ @class CrossCorrelator
+ @brief FFT-based cross-correlation of two channels and delay estimation, with
+ optional GCC-PHAT weighting.
+
+ Frames of N samples are zero-padded to 2N and transformed with RealFFT; the
+ cross-spectrum Y.conj(X) is weighted, then transformed back to a linear
+ cross-correlation whose lags range from -(N-1) to N-1. The PHAT weighting
+ keeps only the phase of the cross-spectrum, which whitens the correlation
+ and makes its peak sharp and close to 1 for a pure delay.
+
+ In streaming mode, push() takes blocks of any size and every complete frame
+ updates an exponential average of the cross-spectrum; getEstimate() weights
+ and transforms the average. The lag is found with a parabolic interpolation
+ around the peak, for sub-sample precision.
+
+ A positive lag means that Y is late: y[n] = x[n - lag].
+ */
+template <typename T>
+class CrossCorrelator
+{
+public:
+    struct Estimate
+    {
+        T mLag;
+        T mPeak;
+    };
+
+    /**
+     @param pFrameSize The frame size N, a power of 2.
+     @param pWeighting The weighting of the cross-spectrum.
+     @param pAveraging The weight of each new frame in the streaming average of
+     the cross-spectrum, in (0, 1]: 1 keeps only the last frame.
+     */
+    CrossCorrelator(size_t pFrameSize, CrossCorrelationWeighting pWeighting = CrossCorrelationWeighting::PHAT,
+                    T pAveraging = (T)1)
+    : mFrameSize(pFrameSize)
+    , mWeighting(pWeighting)
+    , mAveraging(pAveraging)
+    , mFFT(RealFFT<T>::get(2 * pFrameSize))
+    , mPadded(2 * pFrameSize)
+    , mSpectrumX(mFFT->getNumBins())
+    , mSpectrumY(mFFT->getNumBins())
+    , mCrossSpectrum(mFFT->getNumBins())
+    , mAverage(mFFT->getNumBins())
+    , mCorrelation(2 * pFrameSize)
+    , mFrameX(pFrameSize)
+    , mFrameY(pFrameSize)
+    {
+        assert(pAveraging > (T)0 && pAveraging <= (T)1);
+        reset();
+    }
+
+    size_t getFrameSize() const
+    {
+        return mFrameSize;
+    }
+
+    /**
+     The size of the correlations written by correlate().
+     */
+    size_t getCorrelationSize() const
+    {
+        return 2 * mFrameSize;
+    }
+
+    void setAveraging(T pAveraging)
+    {
+        assert(pAveraging > (T)0 && pAveraging <= (T)1);
+        mAveraging = pAveraging;
+    }
+
+    void reset()
+    {
+        std::fill(mAverage.begin(), mAverage.end(), Complex<T>({(T)0, (T)0}));
+        mPosition = 0;
+        mNumFrames = 0;
+    }
+
+    /**
+     Cross-correlation of one frame of each channel, independently of the
+     streaming state.
+     @param pOut getCorrelationSize() values: lag k >= 0 is at pOut[k], lag -k
+     at pOut[getCorrelationSize() - k].
+     */
+    void correlate(const T* pX, const T* pY, T* pOut)
+    {
+        crossSpectrum(pX, pY);
+        weightAndTransform(mCrossSpectrum.data(), pOut);
+    }
+
+    /**
+     Delay of one frame of Y relative to one frame of X.
+     @param pMaxLag The largest absolute lag searched, at most N - 1.
+     */
+    Estimate estimate(const T* pX, const T* pY, size_t pMaxLag)
+    {
+        correlate(pX, pY, mCorrelation.data());
+        return findPeak(mCorrelation.data(), getCorrelationSize(), pMaxLag);
+    }
+
+    /**
+     Streaming input: any number of samples of both channels.
+     */
+    void push(const T* pX, const T* pY, size_t pNumSamples)
+    {
+        while (pNumSamples != 0)
+        {
+            size_t n = std::min(pNumSamples, mFrameSize - mPosition);
+            std::copy(pX, pX + n, mFrameX.begin() + (std::ptrdiff_t)mPosition);
+            std::copy(pY, pY + n, mFrameY.begin() + (std::ptrdiff_t)mPosition);
+            mPosition += n;
+            if (mPosition == mFrameSize)
+            {
+                crossSpectrum(mFrameX.data(), mFrameY.data());
+                // the first frame initializes the average
+                T lWeight = mNumFrames == 0 ? (T)1 : mAveraging;
+                vectProductSC_I((T)1 - lWeight, mAverage.data(), mAverage.size());
+                vectScaleAdd(lWeight, mCrossSpectrum.data(), mAverage.data(), mAverage.size());
+                mPosition = 0;
+                ++mNumFrames;
+            }
+            pX += n;
+            pY += n;
+            pNumSamples -= n;
+        }
+    }
+
+    /**
+     The number of frames averaged since the last reset().
+     */
+    int getNumFrames() const
+    {
+        return mNumFrames;
+    }
+
+    /**
+     Delay estimated from the averaged cross-spectrum of the streaming input.
+     */
+    Estimate getEstimate(size_t pMaxLag)
+    {
+        std::copy(mAverage.begin(), mAverage.end(), mCrossSpectrum.begin());
+        weightAndTransform(mCrossSpectrum.data(), mCorrelation.data());
+        return findPeak(mCorrelation.data(), getCorrelationSize(), pMaxLag);
+    }
+
+    /**
+     Peak of a circular correlation (lag -k at pSize - k) within
+     [-pMaxLag, pMaxLag], refined by parabolic interpolation.
+     */
+    static Estimate findPeak(const T* pCorrelation, size_t pSize, size_t pMaxLag)
+    {
+        assert(pMaxLag < pSize / 2);
+        auto lAt = [pCorrelation, pSize](long pLag) {
+            return pCorrelation[pLag >= 0 ? (size_t)pLag : pSize - (size_t)(- pLag)];
+        };
+        long lMaxLag = (long)pMaxLag;
+        long lBest = 0;
+        for (long k = - lMaxLag ; k <= lMaxLag ; ++k)
+        {
+            if (lAt(k) > lAt(lBest))
+            {
+                lBest = k;
+            }
+        }
+        T lPeak = lAt(lBest);
+        T lOffset = (T)0;
+        if (lBest > - lMaxLag && lBest < lMaxLag)
+        {
+            T lPrevious = lAt(lBest - 1);
+            T lNext = lAt(lBest + 1);
+            T lCurvature = lPrevious - (T)2 * lPeak + lNext;
+            if (lCurvature < (T)0)
+            {
+                lOffset = (T)0.5 * (lPrevious - lNext) / lCurvature;
+                lPeak -= (T)0.25 * (lPrevious - lNext) * lOffset;
+            }
+        }
+        return {(T)lBest + lOffset, lPeak};
+    }
+
+private:
+    void crossSpectrum(const T* pX, const T* pY)
+    {
+        std::fill(mPadded.begin() + (std::ptrdiff_t)mFrameSize, mPadded.end(), (T)0);
+        std::copy(pX, pX + mFrameSize, mPadded.begin());
+        mFFT->forward(mPadded.data(), mSpectrumX.data());
+        std::fill(mPadded.begin() + (std::ptrdiff_t)mFrameSize, mPadded.end(), (T)0);
+        std::copy(pY, pY + mFrameSize, mPadded.begin());
+        mFFT->forward(mPadded.data(), mSpectrumY.data());
+        std::fill(mCrossSpectrum.begin(), mCrossSpectrum.end(), Complex<T>({(T)0, (T)0}));
+        vectConjMultiplyAccumulate(mSpectrumY.data(), mSpectrumX.data(), mCrossSpectrum.data(), mCrossSpectrum.size());
+    }
+
+    void weightAndTransform(Complex<T>* pSpectrum, T* pOut)
+    {
+        if (mWeighting == CrossCorrelationWeighting::PHAT)
+        {
+            for (size_t k = 0 ; k != mCrossSpectrum.size() ; ++k)
+            {
+                T lMagnitude = std::sqrt(pSpectrum[k].sqrmag());
+                pSpectrum[k] *= lMagnitude > (T)0 ? (T)1 / lMagnitude : (T)0;
+            }
+        }
+        mFFT->inverse(pSpectrum, pOut);
+    }
+
+    size_t                              mFrameSize;
+    CrossCorrelationWeighting           mWeighting;
+    T                                   mAveraging;
+    std::shared_ptr< const RealFFT<T> > mFFT;
+    std::vector<T>                      mPadded;
+    std::vector< Complex<T> >           mSpectrumX;
+    std::vector< Complex<T> >           mSpectrumY;
+    std::vector< Complex<T> >           mCrossSpectrum;
+    std::vector< Complex<T> >           mAverage;
+    std::vector<T>                      mCorrelation;
+    std::vector<T>                      mFrameX;
+    std::vector<T>                      mFrameY;
+    size_t                              mPosition;
+    int                                 mNumFrames;
+};
+
+typedef CrossCorrelator<float> CrossCorrelatorf;
+
+}
+
+#endif
@@ -0,0 +1,334 @@
+#ifndef FBU_DIRECTION_INTERPOLATION_HPP_INCLUDED
+#define FBU_DIRECTION_INTERPOLATION_HPP_INCLUDED
+
+/**
+ @file direction_interpolation.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/vector3.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+//==============================================================================
+/**
+ Normalized linear interpolation between two arrays of unit directions:
+ trigonometry-free, but not constant speed along the great circle.
+ Antipodal pairs yield pA.
+ */
+template <typename T>
+void vectNlerp(const Vector3<T>* pA, const Vector3<T>* pB, T pT, Vector3<T>* pOut, size_t pSize)
+{
+    const T lWeightA = (T)1 - pT;
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        Vector3<T> lV = lWeightA * pA[u] + pT * pB[u];
+        pOut[u] = lV.normalizedWithDefault(pA[u]);
+    }
+}
+
+/**
+ The unit vector orthogonal to pA in the plane of the great circle from pA to
+ pB, given their cosine. For (nearly) antipodal directions the plane is
+ undefined: a deterministic perpendicular to pA is used, so that the motion
+ stays on a great circle.
+ */
+template <typename T>
+Vector3<T> slerpPerpendicular(const Vector3<T>& pA, const Vector3<T>& pB, T pCos)
+{
+    Vector3<T> lPerpendicular = pB - pCos * pA;
+    T lSqrLength = lPerpendicular.dot(lPerpendicular);
+    if (lSqrLength > (T)1e-8)
+    {
+        return ((T)1 / std::sqrt(lSqrLength)) * lPerpendicular;
+    }
+    // the basis axis least aligned with pA
+    T lX = std::abs(pA.mX), lY = std::abs(pA.mY), lZ = std::abs(pA.mZ);
+    Vector3<T> lAxis = lX <= lY && lX <= lZ ? Vector3<T>::cartesian((T)1, (T)0, (T)0)
+                     : (lY <= lZ ? Vector3<T>::cartesian((T)0, (T)1, (T)0)
+                                 : Vector3<T>::cartesian((T)0, (T)0, (T)1));
+    lPerpendicular = lAxis - pA.dot(lAxis) * pA;
+    return ((T)1 / lPerpendicular.length()) * lPerpendicular;
+}
+
+/**
+ Spherical linear interpolation between two arrays of unit directions, as
+ cos(t.θ).a + sin(t.θ).p with p the unit perpendicular to a towards b.
+ Falls back to nlerp for close directions. Antipodal pairs follow a
+ deterministic great circle (see slerpPerpendicular()).
+ */
+template <typename T>
+void vectSlerp(const Vector3<T>* pA, const Vector3<T>* pB, T pT, Vector3<T>* pOut, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        T lCos = mu::limitedRange(pA[u].dot(pB[u]), (T)(-1), (T)1);
+        if (lCos > (T)0.9995)
+        {
+            vectNlerp(pA + u, pB + u, pT, pOut + u, 1);
+            continue;
+        }
+        T lAngle = pT * std::acos(lCos);
+        pOut[u] = std::cos(lAngle) * pA[u] + std::sin(lAngle) * slerpPerpendicular(pA[u], pB[u], lCos);
+    }
+}
+
+/**
+ pNumSteps directions per element, equally spaced in angle from pA (excluded)
+ to pB (included), such as the positions at the end of each sub-block.
+ pOut is step-major: step s of element u is pOut[s * pSize + u].
+ Only one acos per element: the steps are generated by the recurrence
+ v(k+1) = 2.cos(δ).v(k) - v(k-1), which holds for any great circle motion.
+ Nothing is written when pNumSteps <= 0.
+ */
+template <typename T>
+void vectSlerpSteps(const Vector3<T>* pA, const Vector3<T>* pB, int pNumSteps, Vector3<T>* pOut, size_t pSize)
+{
+    if (pNumSteps <= 0)
+    {
+        return;
+    }
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        T lCos = mu::limitedRange(pA[u].dot(pB[u]), (T)(-1), (T)1);
+        if (lCos > (T)0.9995)
+        {
+            for (int s = 0 ; s != pNumSteps ; ++s)
+            {
+                vectNlerp(pA + u, pB + u, (T)(s + 1) / (T)pNumSteps, pOut + (size_t)s * pSize + u, 1);
+            }
+            continue;
+        }
+        T lStep = std::acos(lCos) / (T)pNumSteps;
+        T lTwoCosStep = (T)2 * std::cos(lStep);
+        // first step from the perpendicular, then the recurrence
+        Vector3<T> lPrevious = pA[u];
+        Vector3<T> lCurrent = std::cos(lStep) * pA[u] + std::sin(lStep) * slerpPerpendicular(pA[u], pB[u], lCos);
+        for (int s = 0 ; s != pNumSteps ; ++s)
+        {
+            pOut[(size_t)s * pSize + u] = lCurrent;
+            Vector3<T> lNext = lTwoCosStep * lCurrent - lPrevious;
+            lPrevious = lCurrent;
+            lCurrent = lNext;
+        }
+        // cancel the accumulated rounding errors on the last step
+        pOut[(size_t)(pNumSteps - 1) * pSize + u] = pB[u];
+    }
+}
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ @class DirectionSmoother
+ @brief Smooths the directions of many objects, one sub-block at a time.
+
+ The state is stored as separate X, Y, Z arrays and every sub-block runs the
+ same branchless loops over all the objects, so that they vectorize. The
+ interpolation is done in cartesian space, then renormalized: this follows the
+ great circle without any trigonometry.
+
+ - OnePole: exponential approach to the target with a time constant.
+ - LinearRamp: reaches the target in a fixed number of sub-blocks.
+ */
+template <typename T>
+class DirectionSmoother
+{
+public:
+    enum class Mode
+    {
+        OnePole,
+        LinearRamp
+    };
+
+    /**
+     @param pNumObjects The number of objects.
+     @param pMode The smoothing mode.
+     @param pSubBlocks For OnePole, the time constant in sub-blocks; for
+     LinearRamp, the duration of a ramp in sub-blocks.
+     */
+    DirectionSmoother(size_t pNumObjects, Mode pMode = Mode::OnePole, T pSubBlocks = (T)4)
+    : mMode(pMode)
+    , mX(pNumObjects, (T)1), mY(pNumObjects), mZ(pNumObjects)
+    , mTargetX(pNumObjects, (T)1), mTargetY(pNumObjects), mTargetZ(pNumObjects)
+    , mStepX(pNumObjects), mStepY(pNumObjects), mStepZ(pNumObjects)
+    , mRemainingSteps(pNumObjects, 0)
+    , mOutput(pNumObjects, Vector3<T>::cartesian((T)1, (T)0, (T)0))
+    {
+        setSubBlocks(pSubBlocks);
+    }
+
+    size_t getNumObjects() const
+    {
+        return mX.size();
+    }
+
+    void setSubBlocks(T pSubBlocks)
+    {
+        mSubBlocks = std::max(pSubBlocks, (T)1);
+        mOnePoleCoefficient = (T)1 - std::exp((T)(-1) / mSubBlocks);
+    }
+
+    /**
+     Jump to a direction without smoothing.
+     */
+    void reset(size_t pObject, const Vector3<T>& pDirection)
+    {
+        Vector3<T> lDir = pDirection.normalizedWithDefault(Vector3<T>::cartesian((T)1, (T)0, (T)0));
+        mX[pObject] = mTargetX[pObject] = lDir.mX;
+        mY[pObject] = mTargetY[pObject] = lDir.mY;
+        mZ[pObject] = mTargetZ[pObject] = lDir.mZ;
+        mStepX[pObject] = mStepY[pObject] = mStepZ[pObject] = (T)0;
+        mRemainingSteps[pObject] = 0;
+        mOutput[pObject] = lDir;
+    }
+
+    void reset(size_t pObject, const AE<T>& pDirection)
+    {
+        reset(pObject, Vector3<T>::fromAE(pDirection));
+    }
+
+    void setTarget(size_t pObject, const Vector3<T>& pDirection)
+    {
+        Vector3<T> lDir = pDirection.normalizedWithDefault(mOutput[pObject]);
+        mTargetX[pObject] = lDir.mX;
+        mTargetY[pObject] = lDir.mY;
+        mTargetZ[pObject] = lDir.mZ;
+        if (mMode == Mode::LinearRamp)
+        {
+            // restart the ramp from the current (renormalized) position
+            mX[pObject] = mOutput[pObject].mX;
+            mY[pObject] = mOutput[pObject].mY;
+            mZ[pObject] = mOutput[pObject].mZ;
+            int lSteps = std::max(1, (int)std::lround(mSubBlocks));
+            T lInvSteps = (T)1 / (T)lSteps;
+            mStepX[pObject] = (lDir.mX - mX[pObject]) * lInvSteps;
+            mStepY[pObject] = (lDir.mY - mY[pObject]) * lInvSteps;
+            mStepZ[pObject] = (lDir.mZ - mZ[pObject]) * lInvSteps;
+            mRemainingSteps[pObject] = lSteps;
+        }
+    }
+
+    void setTarget(size_t pObject, const AE<T>& pDirection)
+    {
+        setTarget(pObject, Vector3<T>::fromAE(pDirection));
+    }
+
+    template <class D>
+    void setTargets(const D* pDirections)
+    {
+        for (size_t u = 0 ; u != getNumObjects() ; ++u)
+        {
+            setTarget(u, pDirections[u]);
+        }
+    }
+
+    /**
+     Advance one sub-block.
+     @return the normalized directions of all the objects.
+     */
+    const Vector3<T>* process()
+    {
+        const size_t n = getNumObjects();
+        if (mMode == Mode::OnePole)
+        {
+            const T a = mOnePoleCoefficient;
+            for (size_t u = 0 ; u != n ; ++u)
+            {
+                mX[u] += a * (mTargetX[u] - mX[u]);
+                mY[u] += a * (mTargetY[u] - mY[u]);
+                mZ[u] += a * (mTargetZ[u] - mZ[u]);
+            }
+        }
+        else
+        {
+            for (size_t u = 0 ; u != n ; ++u)
+            {
+                mX[u] += mStepX[u];
+                mY[u] += mStepY[u];
+                mZ[u] += mStepZ[u];
+            }
+            for (size_t u = 0 ; u != n ; ++u)
+            {
+                if (mRemainingSteps[u] > 0 && --mRemainingSteps[u] == 0)
+                {
+                    mX[u] = mTargetX[u];
+                    mY[u] = mTargetY[u];
+                    mZ[u] = mTargetZ[u];
+                    mStepX[u] = mStepY[u] = mStepZ[u] = (T)0;
+                }
+            }
+        }
+        for (size_t u = 0 ; u != n ; ++u)
+        {
+            T lSqrLength = mX[u] * mX[u] + mY[u] * mY[u] + mZ[u] * mZ[u];
+            // crossing the center (antipodal move): keep the previous direction
+            if (lSqrLength > (T)1e-12)
+            {
+                T lInvLength = mu::finvsqrt(lSqrLength);
+                mOutput[u].mX = mX[u] * lInvLength;
+                mOutput[u].mY = mY[u] * lInvLength;
+                mOutput[u].mZ = mZ[u] * lInvLength;
+            }
+        }
+        return mOutput.data();
+    }
+
+    /**
+     Advance pNumSubBlocks sub-blocks. pOut is sub-block-major: the direction
+     of object u at sub-block s is pOut[s * getNumObjects() + u].
+     */
+    void process(int pNumSubBlocks, Vector3<T>* pOut)
+    {
+        for (int s = 0 ; s != pNumSubBlocks ; ++s)
+        {
+            const Vector3<T>* lDirections = process();
+            std::copy(lDirections, lDirections + getNumObjects(), pOut + (size_t)s * getNumObjects());
+        }
+    }
+
+    const Vector3<T>* getDirections() const
+    {
+        return mOutput.data();
+    }
+
+private:
+    Mode           mMode;
+    T              mSubBlocks;
+    T              mOnePoleCoefficient;
+    std::vector<T> mX, mY, mZ;
+    std::vector<T> mTargetX, mTargetY, mTargetZ;
+    std::vector<T> mStepX, mStepY, mStepZ;
+    std::vector<int> mRemainingSteps;
+    std::vector< Vector3<T> > mOutput;
+};
+
+}
+
+#endif
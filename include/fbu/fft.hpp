@@ -0,0 +1,418 @@
+#ifndef FBU_FFT_HPP_INCLUDED
+#define FBU_FFT_HPP_INCLUDED
+
+/**
+ @file fft.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/complex.hpp"
+#include "fbu/math_utils.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ @class FFT
+ @brief Power-of-2 complex FFT plan over Complex<T> arrays.
+
+ The plan precomputes the bit-reversal permutation and the twiddle factors of
+ every stage. The transform is a decimation-in-time radix-2^2 FFT: pairs of
+ radix-2 stages are fused into radix-4 butterflies (3 complex multiplies per 4
+ points), preceded by one radix-2 stage when log2(size) is odd. Each stage is a
+ loop over contiguous butterflies with contiguous twiddles, which the compiler
+ vectorizes.
+
+ The forward transform is unscaled, the inverse transform is scaled by
+ 1/size, so that inverse(forward(x)) == x.
+
+ Plans are immutable and can be shared between threads; get() returns a plan
+ from a process-wide cache. Transforms never allocate.
+ */
+template <typename T>
+class FFT
+{
+public:
+    explicit FFT(size_t pSize)
+    : mSize(pSize)
+    {
+        assert(pSize != 0 && (pSize & (pSize - 1)) == 0);
+        int lLog2 = 0;
+        while (((size_t)1 << lLog2) < pSize)
+        {
+            ++lLog2;
+        }
+        mLog2Size = lLog2;
+
+        // bit-reversal permutation
+        for (size_t i = 0 ; i != pSize ; ++i)
+        {
+            size_t lReversed = 0;
+            for (int b = 0 ; b != lLog2 ; ++b)
+            {
+                lReversed |= ((i >> b) & 1u) << (lLog2 - 1 - b);
+            }
+            mBitReversal.push_back(lReversed);
+        }
+
+        // twiddles of the radix-4 stages: t1, t2 and t3 for each k of the stage
+        size_t m = (lLog2 & 1) ? 2 : 1;
+        while (m < pSize)
+        {
+            mStageOffsets.push_back(mTwiddles.size());
+            for (size_t k = 0 ; k != m ; ++k)
+            {
+                for (int p = 1 ; p <= 3 ; ++p)
+                {
+                    double lAngle = - 2. * M_PI * (double)(p * k) / (double)(4 * m);
+                    mTwiddles.push_back({(T)std::cos(lAngle), (T)std::sin(lAngle)});
+                }
+            }
+            m *= 4;
+        }
+    }
+
+    /**
+     A shared plan from the process-wide cache. This locks a mutex and may
+     allocate the first time a size is requested: call it at setup time.
+     */
+    static std::shared_ptr< const FFT<T> > get(size_t pSize)
+    {
+        static std::mutex sMutex;
+        static std::map< size_t, std::shared_ptr< const FFT<T> > > sCache;
+        std::lock_guard<std::mutex> lGuard(sMutex);
+        std::shared_ptr< const FFT<T> >& lPlan = sCache[pSize];
+        if (!lPlan)
+        {
+            lPlan = std::make_shared< const FFT<T> >(pSize);
+        }
+        return lPlan;
+    }
+
+    size_t getSize() const
+    {
+        return mSize;
+    }
+
+    int getOrder() const
+    {
+        return mLog2Size;
+    }
+
+    /**
+     Forward transform. pIn and pOut may be the same array.
+     */
+    void forward(const Complex<T>* pIn, Complex<T>* pOut) const
+    {
+        permute(pIn, pOut);
+        transform<false>(pOut);
+    }
+
+    /**
+     Inverse transform, scaled by 1/size. pIn and pOut may be the same array.
+     */
+    void inverse(const Complex<T>* pIn, Complex<T>* pOut) const
+    {
+        permute(pIn, pOut);
+        transform<true>(pOut);
+        vectProductSC_I((T)1 / (T)mSize, pOut, mSize);
+    }
+
+    /**
+     Inverse transform without the 1/size scaling.
+     */
+    void inverseUnscaled(const Complex<T>* pIn, Complex<T>* pOut) const
+    {
+        permute(pIn, pOut);
+        transform<true>(pOut);
+    }
+
+    /**
+     The plan tables, for transforms over another data layout (BatchFFT): the
+     input is permuted with pOut[getBitReversal()[i]] = pIn[i], then goes
+     through one radix-2 stage if getOrder() is odd, and through the radix-4
+     stages with getStageTwiddles() and radix4Butterfly().
+     */
+    const size_t* getBitReversal() const
+    {
+        return mBitReversal.data();
+    }
+
+    int getNumRadix4Stages() const
+    {
+        return (int)mStageOffsets.size();
+    }
+
+    /**
+     The twiddles t1, t2 and t3 of each k of a radix-4 stage, for the forward
+     transform.
+     */
+    const Complex<T>* getStageTwiddles(int pStage) const
+    {
+        return mTwiddles.data() + mStageOffsets[(size_t)pStage];
+    }
+
+    /**
+     A = x0, B = x1, C = x2, D = x3 in bit-reversed order, pTwiddles = t1, t2, t3:
+     x0 = A + t2.B + t1.C + t3.D
+     x1 = A - t2.B -+ i.(t1.C - t3.D)
+     x2 = A + t2.B - t1.C - t3.D
+     x3 = A - t2.B +- i.(t1.C - t3.D)
+     */
+    template <bool INVERSE>
+    static void radix4Butterfly(Complex<T>& x0, Complex<T>& x1, Complex<T>& x2, Complex<T>& x3, const Complex<T>* pTwiddles)
+    {
+        Complex<T> t1 = pTwiddles[0];
+        Complex<T> t2 = pTwiddles[1];
+        Complex<T> t3 = pTwiddles[2];
+        if (INVERSE)
+        {
+            t1.im = -t1.im;
+            t2.im = -t2.im;
+            t3.im = -t3.im;
+        }
+        const Complex<T> a = x0;
+        const Complex<T> b = t2 * x1;
+        const Complex<T> c = t1 * x2;
+        const Complex<T> d = t3 * x3;
+        const Complex<T> lApB = a + b;
+        const Complex<T> lAmB = a - b;
+        const Complex<T> lCpD = c + d;
+        const Complex<T> lCmD = c - d;
+        // -i.(c - d) for the forward transform, +i.(c - d) for the inverse
+        const Complex<T> lRot = INVERSE ? Complex<T>({- lCmD.im, lCmD.re})
+                                        : Complex<T>({lCmD.im, - lCmD.re});
+        x0 = lApB + lCpD;
+        x2 = lApB - lCpD;
+        x1 = lAmB + lRot;
+        x3 = lAmB - lRot;
+    }
+
+private:
+    void permute(const Complex<T>* pIn, Complex<T>* pOut) const
+    {
+        if (pIn == pOut)
+        {
+            for (size_t i = 0 ; i != mSize ; ++i)
+            {
+                size_t j = mBitReversal[i];
+                if (i < j)
+                {
+                    Complex<T> lTmp = pOut[i];
+                    pOut[i] = pOut[j];
+                    pOut[j] = lTmp;
+                }
+            }
+        }
+        else
+        {
+            for (size_t i = 0 ; i != mSize ; ++i)
+            {
+                pOut[mBitReversal[i]] = pIn[i];
+            }
+        }
+    }
+
+    template <bool INVERSE>
+    void transform(Complex<T>* pData) const
+    {
+        size_t m = 1;
+        if (mLog2Size & 1)
+        {
+            // radix-2 stage, trivial twiddles
+            for (size_t i = 0 ; i < mSize ; i += 2)
+            {
+                Complex<T> a = pData[i];
+                Complex<T> b = pData[i + 1];
+                pData[i] = a + b;
+                pData[i + 1] = a - b;
+            }
+            m = 2;
+        }
+        for (size_t lStage = 0 ; m < mSize ; ++lStage, m *= 4)
+        {
+            const Complex<T>* lTwiddles = mTwiddles.data() + mStageOffsets[lStage];
+            for (size_t lBlock = 0 ; lBlock < mSize ; lBlock += 4 * m)
+            {
+                radix4Butterflies<INVERSE>(pData + lBlock, lTwiddles, m);
+            }
+        }
+    }
+
+    template <bool INVERSE>
+    static void radix4Butterflies(Complex<T>* __restrict pData, const Complex<T>* __restrict pTwiddles, size_t m)
+    {
+        Complex<T>* __restrict x0 = pData;
+        Complex<T>* __restrict x1 = pData + m;
+        Complex<T>* __restrict x2 = pData + 2 * m;
+        Complex<T>* __restrict x3 = pData + 3 * m;
+        for (size_t k = 0 ; k != m ; ++k)
+        {
+            radix4Butterfly<INVERSE>(x0[k], x1[k], x2[k], x3[k], pTwiddles + 3 * k);
+        }
+    }
+
+    size_t                    mSize;
+    int                       mLog2Size;
+    std::vector<size_t>       mBitReversal;
+    std::vector< Complex<T> > mTwiddles;
+    std::vector<size_t>       mStageOffsets;
+};
+
+typedef FFT<float> FFTf;
+typedef FFT<double> FFTd;
+
+//==============================================================================
+/**
+ @class RealFFT
+ @brief Power-of-2 real FFT plan, with packed half-spectrum output.
+
+ The N real samples are transformed as N/2 complex samples with FFT<T>, then a
+ post-processing pass with N/2 twiddles separates the spectra of the even and
+ odd samples and combines them into the N/2+1 bins from DC to Nyquist. The
+ other half of the spectrum is the conjugate symmetric of these bins.
+
+ Same conventions as FFT<T>: unscaled forward, inverse scaled by 1/N, plans
+ shared through get(), no allocation in the transforms.
+ */
+template <typename T>
+class RealFFT
+{
+    static_assert(sizeof(Complex<T>) == 2 * sizeof(T), "Complex<T> must be two packed T");
+
+public:
+    explicit RealFFT(size_t pSize)
+    : mSize(pSize)
+    , mHalfFFT(FFT<T>::get(std::max(pSize / 2, (size_t)1)))
+    {
+        assert(pSize >= 2 && (pSize & (pSize - 1)) == 0);
+        size_t lHalfSize = pSize / 2;
+        for (size_t k = 0 ; k <= lHalfSize ; ++k)
+        {
+            double lAngle = - 2. * M_PI * (double)k / (double)pSize;
+            mTwiddles.push_back({(T)std::cos(lAngle), (T)std::sin(lAngle)});
+        }
+    }
+
+    static std::shared_ptr< const RealFFT<T> > get(size_t pSize)
+    {
+        static std::mutex sMutex;
+        static std::map< size_t, std::shared_ptr< const RealFFT<T> > > sCache;
+        std::lock_guard<std::mutex> lGuard(sMutex);
+        std::shared_ptr< const RealFFT<T> >& lPlan = sCache[pSize];
+        if (!lPlan)
+        {
+            lPlan = std::make_shared< const RealFFT<T> >(pSize);
+        }
+        return lPlan;
+    }
+
+    size_t getSize() const
+    {
+        return mSize;
+    }
+
+    size_t getNumBins() const
+    {
+        return mSize / 2 + 1;
+    }
+
+    /**
+     @param pIn getSize() real samples.
+     @param pOut getNumBins() bins. Also used as scratch buffer.
+     */
+    void forward(const T* pIn, Complex<T>* pOut) const
+    {
+        const size_t m = mSize / 2;
+        std::copy(pIn, pIn + mSize, reinterpret_cast<T*>(pOut));
+        mHalfFFT->forward(pOut, pOut);
+        // X[k] = (Z[k] + Z*[m-k]) / 2 - i.W^k.(Z[k] - Z*[m-k]) / 2, with Z[m] = Z[0]
+        Complex<T> z0 = pOut[0];
+        pOut[0] = {z0.re + z0.im, (T)0};
+        pOut[m] = {z0.re - z0.im, (T)0};
+        for (size_t k = 1 ; k <= m / 2 ; ++k)
+        {
+            Complex<T> a = pOut[k];
+            Complex<T> b = pOut[m - k];
+            pOut[k] = combine(a, b, mTwiddles[k]);
+            if (k != m - k)
+            {
+                pOut[m - k] = combine(b, a, mTwiddles[m - k]);
+            }
+        }
+    }
+
+    /**
+     @param pIn getNumBins() bins.
+     @param pOut getSize() real samples. Also used as scratch buffer.
+     */
+    void inverse(const Complex<T>* pIn, T* pOut) const
+    {
+        const size_t m = mSize / 2;
+        Complex<T>* lZ = reinterpret_cast<Complex<T>*>(pOut);
+        // E[k] = (X[k] + X*[m-k]) / 2, O[k] = W^-k.(X[k] - X*[m-k]) / 2, Z[k] = E[k] + i.O[k]
+        for (size_t k = 0 ; k != m ; ++k)
+        {
+            Complex<T> a = pIn[k];
+            Complex<T> b = pIn[m - k].conj();
+            Complex<T> e = (T)0.5 * (a + b);
+            Complex<T> o = (T)0.5 * ((a - b) * mTwiddles[k].conj());
+            lZ[k] = {e.re - o.im, e.im + o.re};
+        }
+        mHalfFFT->inverse(lZ, lZ);
+    }
+
+private:
+    static Complex<T> combine(Complex<T> pA, Complex<T> pB, Complex<T> pTwiddle)
+    {
+        Complex<T> lBConj = pB.conj();
+        Complex<T> e = (T)0.5 * (pA + lBConj);
+        Complex<T> d = (T)0.5 * (pA - lBConj);
+        // -i.d
+        Complex<T> lMinusID = {d.im, - d.re};
+        return e + pTwiddle * lMinusID;
+    }
+
+    size_t                          mSize;
+    std::shared_ptr< const FFT<T> > mHalfFFT;
+    std::vector< Complex<T> >       mTwiddles;
+};
+
+typedef RealFFT<float> RealFFTf;
+typedef RealFFT<double> RealFFTd;
+
+}
+
+#endif
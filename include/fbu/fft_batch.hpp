@@ -0,0 +1,291 @@
+#ifndef FBU_FFT_BATCH_HPP_INCLUDED
+#define FBU_FFT_BATCH_HPP_INCLUDED
+
+/**
+ @file fft_batch.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/fft.hpp"
+#include "fbu/thread_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ @class BatchFFT
+ @brief Power-of-2 complex FFT of many channels in one call.
+
+ Up to kMaxLaneSize, channels are transformed kNumLanes at a time: they are
+ gathered in bit-reversed order into separate real and imaginary arrays where
+ sample i of lane l is at i * kNumLanes + l. The stages are those of the cached
+ FFT<T> plan, with its tables and butterfly, but every butterfly is a loop over
+ the lanes, which the compiler vectorizes without any shuffle. Larger sizes use
+ FFT<T> channel by channel.
+
+ With a ThreadPool, the groups of channels are split into jobs, one per pool
+ thread plus one run by the calling thread, and the call returns when all the
+ jobs are done. Same conventions as FFT<T>: unscaled forward, inverse scaled
+ by 1/size, input and output may be the same arrays. Transforms do not
+ allocate, but a BatchFFT must not be used from several threads at once.
+ */
+template <typename T>
+class BatchFFT
+{
+public:
+    static constexpr size_t kNumLanes = 8;
+    static constexpr size_t kMaxLaneSize = 256;
+
+    /**
+     @param pSize The FFT size, a power of 2.
+     @param pNumChannels The number of channels transformed by each call.
+     @param pThreadPool The ThreadPool to distribute the channels over, or nullptr.
+     */
+    BatchFFT(size_t pSize, int pNumChannels, ThreadPool* pThreadPool = nullptr)
+    : mSize(pSize)
+    , mNumChannels(pNumChannels)
+    , mThreadPool(pThreadPool)
+    , mFFT(FFT<T>::get(pSize))
+    {
+        assert(pSize != 0 && (pSize & (pSize - 1)) == 0);
+        const size_t lNumUnits = getNumUnits();
+        size_t lNumJobs = mThreadPool != nullptr ? mThreadPool->getNumThreads() + 1 : 1;
+        mNumJobs = std::max(std::min(lNumJobs, lNumUnits), (size_t)1);
+        if (usesLanes())
+        {
+            mScratch.resize(mNumJobs);
+            for (std::vector<T>& s : mScratch)
+            {
+                s.resize(2 * pSize * kNumLanes);
+            }
+        }
+    }
+
+    size_t getSize() const
+    {
+        return mSize;
+    }
+
+    int getNumChannels() const
+    {
+        return mNumChannels;
+    }
+
+    void forward(const Complex<T>* const* pIn, Complex<T>* const* pOut)
+    {
+        run(pIn, pOut, false);
+    }
+
+    void inverse(const Complex<T>* const* pIn, Complex<T>* const* pOut)
+    {
+        run(pIn, pOut, true);
+    }
+
+private:
+    bool usesLanes() const
+    {
+        return mSize <= kMaxLaneSize;
+    }
+
+    // groups of lanes, or single channels
+    size_t getNumUnits() const
+    {
+        return usesLanes() ? ((size_t)mNumChannels + kNumLanes - 1) / kNumLanes : (size_t)mNumChannels;
+    }
+
+    void run(const Complex<T>* const* pIn, Complex<T>* const* pOut, bool pInverse)
+    {
+        mIn = pIn;
+        mOut = pOut;
+        mInverse = pInverse;
+        if (mNumJobs > 1)
+        {
+            for (size_t j = 1 ; j != mNumJobs ; ++j)
+            {
+                mJobCounter.increment();
+                mThreadPool->addJob([this, j]{
+                    runJob(j);
+                    mJobCounter.decrement();
+                });
+            }
+        }
+        runJob(0);
+        mJobCounter.waitForCompletion();
+    }
+
+    void runJob(size_t pJob)
+    {
+        const size_t lNumUnits = getNumUnits();
+        const size_t lBegin = pJob * lNumUnits / mNumJobs;
+        const size_t lEnd = (pJob + 1) * lNumUnits / mNumJobs;
+        for (size_t u = lBegin ; u != lEnd ; ++u)
+        {
+            if (usesLanes())
+            {
+                transformLanes(u * kNumLanes, mScratch[pJob].data());
+            }
+            else if (mInverse)
+            {
+                mFFT->inverse(mIn[u], mOut[u]);
+            }
+            else
+            {
+                mFFT->forward(mIn[u], mOut[u]);
+            }
+        }
+    }
+
+    void transformLanes(size_t pFirstChannel, T* pScratch) const
+    {
+        if (mInverse)
+        {
+            transformLanes<true>(pFirstChannel, pScratch);
+        }
+        else
+        {
+            transformLanes<false>(pFirstChannel, pScratch);
+        }
+    }
+
+    template <bool INVERSE>
+    void transformLanes(size_t pFirstChannel, T* pScratch) const
+    {
+        const size_t L = kNumLanes;
+        const size_t lNumLanes = std::min(L, (size_t)mNumChannels - pFirstChannel);
+        T* __restrict lRe = pScratch;
+        T* __restrict lIm = pScratch + mSize * L;
+
+        // gather, bit-reversed (an involution); the unused lanes are zeroed
+        const size_t* lBitReversal = mFFT->getBitReversal();
+        for (size_t i = 0 ; i != mSize ; ++i)
+        {
+            const size_t lSource = lBitReversal[i];
+            for (size_t l = 0 ; l != L ; ++l)
+            {
+                bool lUsed = l < lNumLanes;
+                lRe[i * L + l] = lUsed ? mIn[pFirstChannel + l][lSource].re : (T)0;
+                lIm[i * L + l] = lUsed ? mIn[pFirstChannel + l][lSource].im : (T)0;
+            }
+        }
+
+        // the stages of FFT<T>, with the lanes as innermost loop
+        size_t m = 1;
+        if (mFFT->getOrder() & 1)
+        {
+            for (size_t i = 0 ; i < mSize ; i += 2)
+            {
+                T* __restrict ar = lRe + i * L;
+                T* __restrict ai = lIm + i * L;
+                T* __restrict br = lRe + (i + 1) * L;
+                T* __restrict bi = lIm + (i + 1) * L;
+                for (size_t l = 0 ; l != L ; ++l)
+                {
+                    T tr = br[l];
+                    T ti = bi[l];
+                    br[l] = ar[l] - tr;
+                    bi[l] = ai[l] - ti;
+                    ar[l] += tr;
+                    ai[l] += ti;
+                }
+            }
+            m = 2;
+        }
+        for (int lStage = 0 ; m < mSize ; ++lStage, m *= 4)
+        {
+            const Complex<T>* lTwiddles = mFFT->getStageTwiddles(lStage);
+            for (size_t lBlock = 0 ; lBlock < mSize ; lBlock += 4 * m)
+            {
+                for (size_t k = 0 ; k != m ; ++k)
+                {
+                    radix4Butterflies<INVERSE>(lRe + (lBlock + k) * L, lIm + (lBlock + k) * L, m * L, lTwiddles + 3 * k);
+                }
+            }
+        }
+
+        // scatter
+        const T lScale = INVERSE ? (T)1 / (T)mSize : (T)1;
+        for (size_t l = 0 ; l != lNumLanes ; ++l)
+        {
+            Complex<T>* lOut = mOut[pFirstChannel + l];
+            for (size_t i = 0 ; i != mSize ; ++i)
+            {
+                lOut[i] = {lScale * lRe[i * L + l], lScale * lIm[i * L + l]};
+            }
+        }
+    }
+
+    /**
+     The radix-4 butterfly of FFT<T> on all the lanes, the 4 points being
+     pStride apart.
+     */
+    template <bool INVERSE>
+    static void radix4Butterflies(T* __restrict pRe, T* __restrict pIm, size_t pStride, const Complex<T>* pTwiddles)
+    {
+        for (size_t l = 0 ; l != kNumLanes ; ++l)
+        {
+            Complex<T> x0 = {pRe[l], pIm[l]};
+            Complex<T> x1 = {pRe[pStride + l], pIm[pStride + l]};
+            Complex<T> x2 = {pRe[2 * pStride + l], pIm[2 * pStride + l]};
+            Complex<T> x3 = {pRe[3 * pStride + l], pIm[3 * pStride + l]};
+            FFT<T>::template radix4Butterfly<INVERSE>(x0, x1, x2, x3, pTwiddles);
+            pRe[l] = x0.re;
+            pIm[l] = x0.im;
+            pRe[pStride + l] = x1.re;
+            pIm[pStride + l] = x1.im;
+            pRe[2 * pStride + l] = x2.re;
+            pIm[2 * pStride + l] = x2.im;
+            pRe[3 * pStride + l] = x3.re;
+            pIm[3 * pStride + l] = x3.im;
+        }
+    }
+
+    size_t                          mSize;
+    int                             mNumChannels;
+    ThreadPool*                     mThreadPool;
+    std::shared_ptr< const FFT<T> > mFFT;
+    size_t                          mNumJobs;
+    std::vector< std::vector<T> >   mScratch;
+    JobCounter                      mJobCounter;
+    // arguments of the current call, read by the jobs
+    const Complex<T>* const*        mIn = nullptr;
+    Complex<T>* const*              mOut = nullptr;
+    bool                            mInverse = false;
+};
+
+template <typename T> constexpr size_t BatchFFT<T>::kNumLanes;
+template <typename T> constexpr size_t BatchFFT<T>::kMaxLaneSize;
+
+typedef BatchFFT<float> BatchFFTf;
+
+}
+
+#endif
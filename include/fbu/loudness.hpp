@@ -0,0 +1,415 @@
+#ifndef FBU_LOUDNESS_HPP_INCLUDED
+#define FBU_LOUDNESS_HPP_INCLUDED
+
+/**
+ @file loudness.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ @class LoudnessHistogram
+ @brief Constant-memory record of gating block loudnesses, for the gated
+ integrated loudness and the loudness range of programs of any length.
+
+ The bins are 0.1 LU wide from the -70 LUFS absolute gate to +10 LUFS. Each
+ bin holds its number of blocks and the sum of their energies, so the gated
+ means are exact except for the bin that straddles the relative gate, which is
+ included when its mean loudness is above the gate.
+ */
+class LoudnessHistogram
+{
+public:
+    static constexpr double kAbsoluteGate = -70.;
+    static constexpr double kMaxLoudness = 10.;
+    static constexpr double kBinWidth = 0.1;
+    static constexpr int kNumBins = 800;
+
+    LoudnessHistogram()
+    : mCounts(kNumBins)
+    , mEnergies(kNumBins)
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        std::fill(mCounts.begin(), mCounts.end(), (uint64_t)0);
+        std::fill(mEnergies.begin(), mEnergies.end(), 0.);
+    }
+
+    /**
+     Record a block, ignored below the absolute gate.
+     */
+    void add(double pEnergy)
+    {
+        double lLoudness = energyToLoudness(pEnergy);
+        if (lLoudness < kAbsoluteGate)
+        {
+            return;
+        }
+        size_t lBin = (size_t)std::min((lLoudness - kAbsoluteGate) / kBinWidth, (double)(kNumBins - 1));
+        ++mCounts[lBin];
+        mEnergies[lBin] += pEnergy;
+    }
+
+    /**
+     @return the first bin above the gate, pRelativeGate LU below the mean of
+     the blocks above the absolute gate, or kNumBins when there is no block.
+     */
+    size_t getFirstGatedBin(double pRelativeGate) const
+    {
+        double lThreshold = energyToLoudness(getMeanEnergy(0)) + pRelativeGate;
+        if (lThreshold < kAbsoluteGate)
+        {
+            return 0;
+        }
+        size_t lBin = (size_t)std::min((lThreshold - kAbsoluteGate) / kBinWidth, (double)kNumBins);
+        if (lBin < kNumBins && mCounts[lBin] != 0
+            && energyToLoudness(mEnergies[lBin] / (double)mCounts[lBin]) < lThreshold)
+        {
+            ++lBin;
+        }
+        return lBin;
+    }
+
+    /**
+     @return the mean energy of the blocks from pFirstBin, or 0 when there is
+     none.
+     */
+    double getMeanEnergy(size_t pFirstBin) const
+    {
+        uint64_t lCount = 0;
+        double lEnergy = 0.;
+        for (size_t u = pFirstBin ; u < kNumBins ; ++u)
+        {
+            lCount += mCounts[u];
+            lEnergy += mEnergies[u];
+        }
+        return lCount != 0 ? lEnergy / (double)lCount : 0.;
+    }
+
+    /**
+     @return the loudness at the center of the bin holding the given quantile
+     (0 to 1) of the blocks from pFirstBin.
+     */
+    double getQuantile(size_t pFirstBin, double pQuantile) const
+    {
+        uint64_t lCount = 0;
+        for (size_t u = pFirstBin ; u < kNumBins ; ++u)
+        {
+            lCount += mCounts[u];
+        }
+        uint64_t lTarget = (uint64_t)(pQuantile * (double)(lCount - 1));
+        uint64_t lSum = 0;
+        for (size_t u = pFirstBin ; u < kNumBins ; ++u)
+        {
+            lSum += mCounts[u];
+            if (lSum > lTarget)
+            {
+                return kAbsoluteGate + ((double)u + 0.5) * kBinWidth;
+            }
+        }
+        return kAbsoluteGate;
+    }
+
+    /**
+     BS.1770 loudness of a mean square energy, floored at -144 LUFS.
+     */
+    static double energyToLoudness(double pEnergy)
+    {
+        return pEnergy > 1e-15 ? -0.691 + 10. * std::log10(pEnergy) : -144.;
+    }
+
+private:
+    std::vector<uint64_t> mCounts;
+    std::vector<double>   mEnergies;
+};
+
+//==============================================================================
+/**
+ @class LoudnessMeter
+ @brief ITU-R BS.1770-4 / EBU R128 loudness of one stream of N channels:
+ momentary (400 ms), short-term (3 s), gated integrated loudness and loudness
+ range (EBU Tech 3342).
+
+ The K-weighting (high shelf then RLB high-pass) is computed for the actual
+ sample rate. Its biquad states are stored per channel in separate arrays and
+ the input is transposed by tiles, so that the filters run over all the
+ channels at once for each sample. The filtered power is accumulated over
+ 100 ms sub-blocks: a 400 ms gating block, with 75% overlap, ends on each of
+ them, and a 3 s short-term window too.
+
+ The channel weights default to 1; set kSurroundWeight for the surround
+ channels and 0 for the LFE.
+ */
+template <typename T>
+class LoudnessMeter
+{
+public:
+    static constexpr T kSurroundWeight = (T)1.41;
+
+    LoudnessMeter(int pNumChannels, double pSampleRate)
+    : mNumChannels(pNumChannels)
+    , mSampleRate(pSampleRate)
+    , mSubBlockSize(std::max(1, (int)std::lround(pSampleRate / 10.)))
+    , mWeights((size_t)pNumChannels, (T)1)
+    , mShelfZ1((size_t)pNumChannels), mShelfZ2((size_t)pNumChannels)
+    , mHighPassZ1((size_t)pNumChannels), mHighPassZ2((size_t)pNumChannels)
+    , mPowers((size_t)pNumChannels)
+    , mTile((size_t)(pNumChannels * kTileSize))
+    {
+        // high shelf
+        {
+            const double f0 = 1681.974450955533;
+            const double G = 3.999843853973347;
+            const double Q = 0.7071752369554196;
+            const double K = std::tan(M_PI * f0 / pSampleRate);
+            const double Vh = std::pow(10., G / 20.);
+            const double Vb = std::pow(Vh, 0.4996667741545416);
+            const double a0 = 1. + K / Q + K * K;
+            mShelfB0 = (T)((Vh + Vb * K / Q + K * K) / a0);
+            mShelfB1 = (T)(2. * (K * K - Vh) / a0);
+            mShelfB2 = (T)((Vh - Vb * K / Q + K * K) / a0);
+            mShelfA1 = (T)(2. * (K * K - 1.) / a0);
+            mShelfA2 = (T)((1. - K / Q + K * K) / a0);
+        }
+        // RLB high-pass, b = {1, -2, 1}
+        {
+            const double f0 = 38.13547087602444;
+            const double Q = 0.5003270373238773;
+            const double K = std::tan(M_PI * f0 / pSampleRate);
+            const double a0 = 1. + K / Q + K * K;
+            mHighPassA1 = (T)(2. * (K * K - 1.) / a0);
+            mHighPassA2 = (T)((1. - K / Q + K * K) / a0);
+        }
+        reset();
+    }
+
+    int getNumChannels() const
+    {
+        return mNumChannels;
+    }
+
+    double getSampleRate() const
+    {
+        return mSampleRate;
+    }
+
+    void setChannelWeight(int pChannel, T pWeight)
+    {
+        mWeights[(size_t)pChannel] = pWeight;
+    }
+
+    T getChannelWeight(int pChannel) const
+    {
+        return mWeights[(size_t)pChannel];
+    }
+
+    /**
+     Restart the measurement, including the integrated loudness and range.
+     */
+    void reset()
+    {
+        std::fill(mShelfZ1.begin(), mShelfZ1.end(), (T)0);
+        std::fill(mShelfZ2.begin(), mShelfZ2.end(), (T)0);
+        std::fill(mHighPassZ1.begin(), mHighPassZ1.end(), (T)0);
+        std::fill(mHighPassZ2.begin(), mHighPassZ2.end(), (T)0);
+        std::fill(mPowers.begin(), mPowers.end(), (T)0);
+        std::fill(mSubBlockEnergies, mSubBlockEnergies + kNumShortTermSubBlocks, 0.);
+        mSubBlockPosition = 0;
+        mSubBlockIndex = 0;
+        mNumSubBlocks = 0;
+        mGatingBlocks.reset();
+        mShortTermBlocks.reset();
+    }
+
+    /**
+     Measure a block of planar channels, of any size.
+     */
+    void process(const T* const* pChannels, int pNumSamples)
+    {
+        int lOffset = 0;
+        while (lOffset != pNumSamples)
+        {
+            int lNumSamples = std::min(std::min(pNumSamples - lOffset, mSubBlockSize - mSubBlockPosition), kTileSize);
+            filterTile(pChannels, lOffset, lNumSamples);
+            lOffset += lNumSamples;
+            mSubBlockPosition += lNumSamples;
+            if (mSubBlockPosition == mSubBlockSize)
+            {
+                endSubBlock();
+            }
+        }
+    }
+
+    /**
+     @return the loudness of the last 400 ms, in LUFS.
+     */
+    double getMomentaryLoudness() const
+    {
+        return LoudnessHistogram::energyToLoudness(getWindowEnergy(kNumMomentarySubBlocks));
+    }
+
+    /**
+     @return the loudness of the last 3 s, in LUFS.
+     */
+    double getShortTermLoudness() const
+    {
+        return LoudnessHistogram::energyToLoudness(getWindowEnergy(kNumShortTermSubBlocks));
+    }
+
+    /**
+     @return the gated loudness since the last reset, in LUFS.
+     */
+    double getIntegratedLoudness() const
+    {
+        return LoudnessHistogram::energyToLoudness(mGatingBlocks.getMeanEnergy(mGatingBlocks.getFirstGatedBin(-10.)));
+    }
+
+    /**
+     @return the loudness range since the last reset, in LU.
+     */
+    double getLoudnessRange() const
+    {
+        size_t lFirstBin = mShortTermBlocks.getFirstGatedBin(-20.);
+        if (lFirstBin >= (size_t)LoudnessHistogram::kNumBins || mShortTermBlocks.getMeanEnergy(lFirstBin) == 0.)
+        {
+            return 0.;
+        }
+        return mShortTermBlocks.getQuantile(lFirstBin, 0.95) - mShortTermBlocks.getQuantile(lFirstBin, 0.10);
+    }
+
+private:
+    static constexpr int kTileSize = 64;
+    static constexpr int kNumMomentarySubBlocks = 4;
+    static constexpr int kNumShortTermSubBlocks = 30;
+
+    void filterTile(const T* const* pChannels, int pOffset, int pNumSamples)
+    {
+        const size_t C = (size_t)mNumChannels;
+        T* __restrict lTile = mTile.data();
+        for (size_t c = 0 ; c != C ; ++c)
+        {
+            const T* lIn = pChannels[c] + pOffset;
+            for (int i = 0 ; i != pNumSamples ; ++i)
+            {
+                lTile[(size_t)i * C + c] = lIn[i];
+            }
+        }
+        T* __restrict lShelfZ1 = mShelfZ1.data();
+        T* __restrict lShelfZ2 = mShelfZ2.data();
+        T* __restrict lHighPassZ1 = mHighPassZ1.data();
+        T* __restrict lHighPassZ2 = mHighPassZ2.data();
+        T* __restrict lPowers = mPowers.data();
+        const T b0 = mShelfB0, b1 = mShelfB1, b2 = mShelfB2, a1 = mShelfA1, a2 = mShelfA2;
+        const T ha1 = mHighPassA1, ha2 = mHighPassA2;
+        for (int i = 0 ; i != pNumSamples ; ++i)
+        {
+            const T* __restrict x = lTile + (size_t)i * C;
+            // transposed direct form II, one lane per channel
+            for (size_t c = 0 ; c != C ; ++c)
+            {
+                T lShelf = b0 * x[c] + lShelfZ1[c];
+                lShelfZ1[c] = b1 * x[c] - a1 * lShelf + lShelfZ2[c];
+                lShelfZ2[c] = b2 * x[c] - a2 * lShelf;
+                T y = lShelf + lHighPassZ1[c];
+                lHighPassZ1[c] = (T)(-2) * lShelf - ha1 * y + lHighPassZ2[c];
+                lHighPassZ2[c] = lShelf - ha2 * y;
+                lPowers[c] += y * y;
+            }
+        }
+    }
+
+    void endSubBlock()
+    {
+        double lEnergy = 0.;
+        for (size_t c = 0 ; c != (size_t)mNumChannels ; ++c)
+        {
+            lEnergy += (double)(mWeights[c] * mPowers[c]);
+            mPowers[c] = (T)0;
+        }
+        mSubBlockEnergies[mSubBlockIndex] = lEnergy / (double)mSubBlockSize;
+        mSubBlockIndex = (mSubBlockIndex + 1) % kNumShortTermSubBlocks;
+        mSubBlockPosition = 0;
+        ++mNumSubBlocks;
+        if (mNumSubBlocks >= (uint64_t)kNumMomentarySubBlocks)
+        {
+            mGatingBlocks.add(getWindowEnergy(kNumMomentarySubBlocks));
+        }
+        if (mNumSubBlocks >= (uint64_t)kNumShortTermSubBlocks)
+        {
+            mShortTermBlocks.add(getWindowEnergy(kNumShortTermSubBlocks));
+        }
+    }
+
+    double getWindowEnergy(int pNumSubBlocks) const
+    {
+        double lEnergy = 0.;
+        for (int b = 1 ; b <= pNumSubBlocks ; ++b)
+        {
+            lEnergy += mSubBlockEnergies[(mSubBlockIndex + kNumShortTermSubBlocks - b) % kNumShortTermSubBlocks];
+        }
+        return lEnergy / (double)pNumSubBlocks;
+    }
+
+    int               mNumChannels;
+    double            mSampleRate;
+    int               mSubBlockSize;
+    T                 mShelfB0, mShelfB1, mShelfB2, mShelfA1, mShelfA2;
+    T                 mHighPassA1, mHighPassA2;
+    std::vector<T>    mWeights;
+    std::vector<T>    mShelfZ1, mShelfZ2;
+    std::vector<T>    mHighPassZ1, mHighPassZ2;
+    std::vector<T>    mPowers;
+    std::vector<T>    mTile;
+    double            mSubBlockEnergies[kNumShortTermSubBlocks];
+    int               mSubBlockPosition;
+    int               mSubBlockIndex;
+    uint64_t          mNumSubBlocks;
+    LoudnessHistogram mGatingBlocks;
+    LoudnessHistogram mShortTermBlocks;
+};
+
+template <typename T> constexpr T LoudnessMeter<T>::kSurroundWeight;
+template <typename T> constexpr int LoudnessMeter<T>::kTileSize;
+template <typename T> constexpr int LoudnessMeter<T>::kNumMomentarySubBlocks;
+template <typename T> constexpr int LoudnessMeter<T>::kNumShortTermSubBlocks;
+
+typedef LoudnessMeter<float> LoudnessMeterf;
+
+}
+
+#endif
@@ -361,6 +361,24 @@ namespace mu
         }
     }
     
+    /**
+     Valid everywhere with an abs error inferior to 0.000003, result in )-π,π).
+     The selections compile to blends, so that the function vectorizes.
+     */
+    inline float fast_atan2(float y, float x)
+    {
+        float ax = std::abs(x);
+        float ay = std::abs(y);
+        float mx = ax > ay ? ax : ay;
+        float mn = ax > ay ? ay : ax;
+        float a = mx > 0.f ? mn / mx : 0.f;
+        float s = a * a;
+        float r = a * (0.99997726f + s * (- 0.33262347f + s * (0.19354346f + s * (- 0.11643287f + s * (0.05265332f - 0.01172120f * s)))));
+        r = ay > ax ? 0.5f * M_PIf - r : r;
+        r = x < 0.f ? M_PIf - r : r;
+        return y < 0.f ? - r : r;
+    }
+    
     //==============================================================================
     /**
      Branchless max
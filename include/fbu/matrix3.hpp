@@ -0,0 +1,261 @@
+#ifndef FBU_MATRIX3_HPP_INCLUDED
+#define FBU_MATRIX3_HPP_INCLUDED
+
+/**
+ @file matrix3.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/vector3.hpp"
+
+#include <cmath>
+#include <cstddef>
+
+//==============================================================================
+/**
+ @brief A POD 3x3 matrix, row-major, mostly used as a rotation matrix.
+
+ Yaw, pitch and roll follow the AEM conventions: yaw is a rotation around Z
+ (positive to the left), pitch raises the front axis (positive to the top) and
+ roll is a rotation around the front axis. The rotation is applied as
+ R = Rz(yaw) . Ry(-pitch) . Rx(roll), so that rotating the front vector (1,0,0)
+ by (yaw, pitch, roll) gives Vector3<T>::fromAE(AE<T>::ae(yaw, pitch)).
+ */
+template <typename T>
+struct Matrix3
+{
+    T m[3][3];
+
+    static Matrix3<T> identity()
+    {
+        return {{{(T)1, (T)0, (T)0},
+                 {(T)0, (T)1, (T)0},
+                 {(T)0, (T)0, (T)1}}};
+    }
+
+    static Matrix3<T> fromYawPitchRoll(T pYaw, T pPitch, T pRoll)
+    {
+        T cy = std::cos(pYaw);
+        T sy = std::sin(pYaw);
+        T cp = std::cos(pPitch);
+        T sp = std::sin(pPitch);
+        T cr = std::cos(pRoll);
+        T sr = std::sin(pRoll);
+        return {{{cy * cp, - sy * cr - cy * sp * sr,   sy * sr - cy * sp * cr},
+                 {sy * cp,   cy * cr - sy * sp * sr, - cy * sr - sy * sp * cr},
+                 {sp,        cp * sr,                  cp * cr}}};
+    }
+
+    /**
+     Rotation of pAngle (rad) around the normalized axis pAxis, right-handed.
+     */
+    static Matrix3<T> fromAxisAngle(const Vector3<T>& pAxis, T pAngle)
+    {
+        T c = std::cos(pAngle);
+        T s = std::sin(pAngle);
+        T t = (T)1 - c;
+        T x = pAxis.mX;
+        T y = pAxis.mY;
+        T z = pAxis.mZ;
+        return {{{t * x * x + c,     t * x * y - s * z, t * x * z + s * y},
+                 {t * x * y + s * z, t * y * y + c,     t * y * z - s * x},
+                 {t * x * z - s * y, t * y * z + s * x, t * z * z + c}}};
+    }
+
+    /**
+     Inverse of fromYawPitchRoll(). In gimbal lock (pitch = ±π/2), the roll is
+     set to 0 and the whole rotation around Z is reported as yaw.
+     */
+    void toYawPitchRoll(T& pYaw, T& pPitch, T& pRoll) const
+    {
+        T lSinPitch = mu::limitedRange(m[2][0], (T)(-1), (T)1);
+        pPitch = std::asin(lSinPitch);
+        if (std::abs(lSinPitch) < (T)0.99999)
+        {
+            pYaw = std::atan2(m[1][0], m[0][0]);
+            pRoll = std::atan2(m[2][1], m[2][2]);
+        }
+        else
+        {
+            pYaw = std::atan2(- m[0][1], m[1][1]);
+            pRoll = (T)0;
+        }
+    }
+
+    Matrix3<T> transposed() const
+    {
+        return {{{m[0][0], m[1][0], m[2][0]},
+                 {m[0][1], m[1][1], m[2][1]},
+                 {m[0][2], m[1][2], m[2][2]}}};
+    }
+
+    /**
+     The inverse of a rotation matrix is its transpose.
+     */
+    Matrix3<T> inverseRotation() const
+    {
+        return transposed();
+    }
+
+    T determinant() const
+    {
+        return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+             - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+             + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    }
+
+    /**
+     General inverse. Returns false and leaves pInverse untouched if the matrix
+     is singular.
+     */
+    bool inverse(Matrix3<T>& pInverse) const
+    {
+        T lDet = determinant();
+        if (lDet == (T)0)
+        {
+            return false;
+        }
+        T lInvDet = (T)1 / lDet;
+        pInverse.m[0][0] = (m[1][1] * m[2][2] - m[1][2] * m[2][1]) * lInvDet;
+        pInverse.m[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * lInvDet;
+        pInverse.m[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * lInvDet;
+        pInverse.m[1][0] = (m[1][2] * m[2][0] - m[1][0] * m[2][2]) * lInvDet;
+        pInverse.m[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * lInvDet;
+        pInverse.m[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * lInvDet;
+        pInverse.m[2][0] = (m[1][0] * m[2][1] - m[1][1] * m[2][0]) * lInvDet;
+        pInverse.m[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * lInvDet;
+        pInverse.m[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * lInvDet;
+        return true;
+    }
+
+    Vector3<T> rotate(const Vector3<T>& pV) const
+    {
+        return {m[0][0] * pV.mX + m[0][1] * pV.mY + m[0][2] * pV.mZ,
+                m[1][0] * pV.mX + m[1][1] * pV.mY + m[1][2] * pV.mZ,
+                m[2][0] * pV.mX + m[2][1] * pV.mY + m[2][2] * pV.mZ};
+    }
+
+    AEM<T> rotate(const AEM<T>& pAEM) const
+    {
+        return AEM<T>::fromVector3(rotate(Vector3<T>::fromAEM(pAEM)));
+    }
+
+    AE<T> rotate(const AE<T>& pAE) const
+    {
+        return AE<T>::fromNormalizedVector3(rotate(Vector3<T>::fromAE(pAE)).normalized());
+    }
+};
+
+template <typename T>
+Matrix3<T> operator *(const Matrix3<T>& pA, const Matrix3<T>& pB)
+{
+    Matrix3<T> lResult;
+    for (int i = 0 ; i != 3 ; ++i)
+    {
+        for (int j = 0 ; j != 3 ; ++j)
+        {
+            lResult.m[i][j] = pA.m[i][0] * pB.m[0][j]
+                            + pA.m[i][1] * pB.m[1][j]
+                            + pA.m[i][2] * pB.m[2][j];
+        }
+    }
+    return lResult;
+}
+
+template <typename T>
+Vector3<T> operator *(const Matrix3<T>& pM, const Vector3<T>& pV)
+{
+    return pM.rotate(pV);
+}
+
+typedef Matrix3<float> Matrix3f;
+
+//==============================================================================
+/**
+ Batch rotation of an array of vectors. The loop body is branchless and only
+ made of multiply-adds so that it gets vectorized by the compiler.
+ */
+template <typename T>
+void vectRotate(const Matrix3<T>& pM, const Vector3<T>* __restrict pIn, Vector3<T>* __restrict pOut, size_t pSize)
+{
+    const T m00 = pM.m[0][0], m01 = pM.m[0][1], m02 = pM.m[0][2];
+    const T m10 = pM.m[1][0], m11 = pM.m[1][1], m12 = pM.m[1][2];
+    const T m20 = pM.m[2][0], m21 = pM.m[2][1], m22 = pM.m[2][2];
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        const T x = pIn[u].mX;
+        const T y = pIn[u].mY;
+        const T z = pIn[u].mZ;
+        pOut[u].mX = m00 * x + m01 * y + m02 * z;
+        pOut[u].mY = m10 * x + m11 * y + m12 * z;
+        pOut[u].mZ = m20 * x + m21 * y + m22 * z;
+    }
+}
+
+template <typename T>
+void vectRotate_I(const Matrix3<T>& pM, Vector3<T>* pInOut, size_t pSize)
+{
+    const T m00 = pM.m[0][0], m01 = pM.m[0][1], m02 = pM.m[0][2];
+    const T m10 = pM.m[1][0], m11 = pM.m[1][1], m12 = pM.m[1][2];
+    const T m20 = pM.m[2][0], m21 = pM.m[2][1], m22 = pM.m[2][2];
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        const T x = pInOut[u].mX;
+        const T y = pInOut[u].mY;
+        const T z = pInOut[u].mZ;
+        pInOut[u].mX = m00 * x + m01 * y + m02 * z;
+        pInOut[u].mY = m10 * x + m11 * y + m12 * z;
+        pInOut[u].mZ = m20 * x + m21 * y + m22 * z;
+    }
+}
+
+/**
+ Batch rotation of vectors stored as separate X, Y and Z arrays. This is the
+ layout that vectorizes best: each output lane is 3 multiply-adds.
+ */
+template <typename T>
+void vectRotateSoA(const Matrix3<T>& pM,
+                   const T* __restrict pInX, const T* __restrict pInY, const T* __restrict pInZ,
+                   T* __restrict pOutX, T* __restrict pOutY, T* __restrict pOutZ,
+                   size_t pSize)
+{
+    const T m00 = pM.m[0][0], m01 = pM.m[0][1], m02 = pM.m[0][2];
+    const T m10 = pM.m[1][0], m11 = pM.m[1][1], m12 = pM.m[1][2];
+    const T m20 = pM.m[2][0], m21 = pM.m[2][1], m22 = pM.m[2][2];
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pOutX[u] = m00 * pInX[u] + m01 * pInY[u] + m02 * pInZ[u];
+    }
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pOutY[u] = m10 * pInX[u] + m11 * pInY[u] + m12 * pInZ[u];
+    }
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pOutZ[u] = m20 * pInX[u] + m21 * pInY[u] + m22 * pInZ[u];
+    }
+}
+
+#endif
@@ -0,0 +1,637 @@
+#ifndef FBU_METER_CORE_HPP_INCLUDED
+#define FBU_METER_CORE_HPP_INCLUDED
+
+/**
+ @file meter_core.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Same compile-time selection as complex_vect.hpp.
+#if !defined(FBU_METER_CORE_USE_SSE)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FBU_METER_CORE_USE_SSE 1
+#else
+#define FBU_METER_CORE_USE_SSE 0
+#endif
+#endif
+
+#if FBU_METER_CORE_USE_SSE
+#include <emmintrin.h>
+#endif
+
+#include "fbu/triple_buffer.hpp"
+
+//==============================================================================
+/**
+ Peak absolute value and sum of squares of a buffer, in a single pass.
+ */
+inline void vectPeakAndSumOfSquares(const float* pIn, size_t pSize, float& pPeak, float& pSumOfSquares)
+{
+    size_t u = 0;
+    float lPeak = 0.f;
+    float lSum = 0.f;
+#if FBU_METER_CORE_USE_SSE
+    const __m128 lAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 lPeak4 = _mm_setzero_ps();
+    __m128 lSum4 = _mm_setzero_ps();
+    for ( ; u + 4 <= pSize ; u += 4)
+    {
+        __m128 x = _mm_loadu_ps(pIn + u);
+        lPeak4 = _mm_max_ps(lPeak4, _mm_and_ps(x, lAbsMask));
+        lSum4 = _mm_add_ps(lSum4, _mm_mul_ps(x, x));
+    }
+    float lPeaks[4];
+    float lSums[4];
+    _mm_storeu_ps(lPeaks, lPeak4);
+    _mm_storeu_ps(lSums, lSum4);
+    lPeak = std::max(std::max(lPeaks[0], lPeaks[1]), std::max(lPeaks[2], lPeaks[3]));
+    lSum = (lSums[0] + lSums[1]) + (lSums[2] + lSums[3]);
+#endif
+    for ( ; u < pSize ; ++u)
+    {
+        lPeak = std::max(lPeak, std::abs(pIn[u]));
+        lSum += pIn[u] * pIn[u];
+    }
+    pPeak = lPeak;
+    pSumOfSquares = lSum;
+}
+
+/**
+ Accumulate the peak absolute value and sum of squares of each channel of an
+ interleaved buffer into pPeaks and pSumsOfSquares, in a single streaming
+ pass: the channels map to the SIMD lanes and the accumulators stay in L1.
+ */
+inline void vectInterleavedPeakAndSumOfSquares(const float* pIn, size_t pNumChannels, size_t pNumFrames,
+                                               float* __restrict pPeaks, float* __restrict pSumsOfSquares)
+{
+#if FBU_METER_CORE_USE_SSE
+    const __m128 lAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+#endif
+    for (size_t f = 0 ; f != pNumFrames ; ++f)
+    {
+        const float* lFrame = pIn + f * pNumChannels;
+        size_t c = 0;
+#if FBU_METER_CORE_USE_SSE
+        for ( ; c + 4 <= pNumChannels ; c += 4)
+        {
+            __m128 x = _mm_loadu_ps(lFrame + c);
+            _mm_storeu_ps(pPeaks + c, _mm_max_ps(_mm_loadu_ps(pPeaks + c), _mm_and_ps(x, lAbsMask)));
+            _mm_storeu_ps(pSumsOfSquares + c, _mm_add_ps(_mm_loadu_ps(pSumsOfSquares + c), _mm_mul_ps(x, x)));
+        }
+#endif
+        for ( ; c != pNumChannels ; ++c)
+        {
+            pPeaks[c] = std::max(pPeaks[c], std::abs(lFrame[c]));
+            pSumsOfSquares[c] += lFrame[c] * lFrame[c];
+        }
+    }
+}
+
+/**
+ Sum of the products of two buffers.
+ */
+inline float vectDotProduct(const float* pA, const float* pB, size_t pSize)
+{
+    float lSum = 0.f;
+#if FBU_METER_CORE_USE_SSE
+    // the vector part, then the scalar tail on what remains
+    const size_t lVectorSize = pSize & ~(size_t)3;
+    __m128 lSum4 = _mm_setzero_ps();
+    for (size_t u = 0 ; u != lVectorSize ; u += 4)
+    {
+        lSum4 = _mm_add_ps(lSum4, _mm_mul_ps(_mm_loadu_ps(pA + u), _mm_loadu_ps(pB + u)));
+    }
+    float lSums[4];
+    _mm_storeu_ps(lSums, lSum4);
+    lSum = (lSums[0] + lSums[1]) + (lSums[2] + lSums[3]);
+    pA += lVectorSize;
+    pB += lVectorSize;
+    pSize -= lVectorSize;
+#endif
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        lSum += pA[u] * pB[u];
+    }
+    return lSum;
+}
+
+/**
+ Accumulate the cross products of channel pairs of an interleaved buffer into
+ pCrossProducts. The pairs are in separate left and right index arrays, so the
+ inner loop runs over all the pairs of a frame.
+ */
+inline void vectInterleavedCrossProducts(const float* pIn, size_t pNumChannels, size_t pNumFrames,
+                                         const int* pLefts, const int* pRights, size_t pNumPairs,
+                                         float* __restrict pCrossProducts)
+{
+    for (size_t f = 0 ; f != pNumFrames ; ++f)
+    {
+        const float* lFrame = pIn + f * pNumChannels;
+        for (size_t p = 0 ; p != pNumPairs ; ++p)
+        {
+            pCrossProducts[p] += lFrame[pLefts[p]] * lFrame[pRights[p]];
+        }
+    }
+}
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ Wait-free for the readers, lock-free for the writers: raise pMax to pValue
+ with a CAS loop, so that concurrent updates never lose the largest value.
+ */
+inline void atomicMax(std::atomic<float>& pMax, float pValue)
+{
+    float lPrevious = pMax.load(std::memory_order_relaxed);
+    while (lPrevious < pValue
+           && !pMax.compare_exchange_weak(lPrevious, pValue, std::memory_order_relaxed))
+    {
+    }
+}
+
+//==============================================================================
+/**
+ @struct MeterBallistics
+ @brief Dynamic response of a level meter, evaluated once per block.
+
+ The level follows the detected amplitude with a one-pole attack, then falls
+ at a constant rate in dB (peak meters) or with a one-pole release (VU). The
+ peak-hold marker keeps the highest block peak for mPeakHoldTime, then drops
+ to the level. Block-rate evaluation is exact for the release and the hold,
+ and approximates the short attacks of the PPMs with blocks of a few ms.
+ */
+struct MeterBallistics
+{
+    enum class Detector
+    {
+        Peak,
+        RMS
+    };
+
+    Detector mDetector;
+    /** One-pole time constant of the rise, in seconds, 0 for instantaneous. */
+    float    mAttackTime;
+    /** Fall rate in dB per second; when 0, mReleaseTime is used. */
+    float    mReleaseRate;
+    /** One-pole time constant of the fall, in seconds. */
+    float    mReleaseTime;
+    /** In seconds, 0 to disable the peak-hold marker. */
+    float    mPeakHoldTime;
+
+    /**
+     IEC 60268-18 digital peak meter: instantaneous, falls 20 dB in 1.7 s.
+     */
+    static MeterBallistics digital()
+    {
+        return {Detector::Peak, 0.f, 20.f / 1.7f, 0.f, 2.f};
+    }
+
+    /**
+     IEC 60268-10 Type I (DIN) PPM: a 10 ms burst reads -1 dB, falls 20 dB
+     in 1.5 s.
+     */
+    static MeterBallistics ppmType1()
+    {
+        return {Detector::Peak, 0.00452f, 20.f / 1.5f, 0.f, 2.f};
+    }
+
+    /**
+     IEC 60268-10 Type II (BBC, EBU) PPM: a 10 ms burst reads -2 dB, falls
+     24 dB in 2.8 s.
+     */
+    static MeterBallistics ppmType2()
+    {
+        return {Detector::Peak, 0.00633f, 24.f / 2.8f, 0.f, 2.f};
+    }
+
+    /**
+     IEC 60268-17 VU meter: 99% of a step in 300 ms, both ways, on the RMS.
+     */
+    static MeterBallistics vu()
+    {
+        return {Detector::RMS, 0.065f, 0.f, 0.065f, 0.f};
+    }
+};
+
+//==============================================================================
+/**
+ @class MeterCore
+ @brief JUCE-free peak and RMS metering of N channels: process() on the audio
+ thread, getSnapshot() or getFrame() from any other thread.
+
+ Each block is scanned once per channel for its peak and sum of squares. The
+ peaks are accumulated with atomicMax() until a snapshot reads and resets
+ them, so no peak is lost between two reads whatever their rate. The RMS is an
+ exponential moving average of the mean square, with the given time constant,
+ published once per block with a relaxed store.
+
+ The ballistics are also evaluated per block on the audio thread, and each
+ block publishes a Frame of display values in dB through a TripleBuffer: the
+ GUI only reads them, so its repaint rate does not change what it shows.
+
+ For stereo pairs, the cross product of the channels is the only extra sum per
+ block. It is smoothed like the mean squares, and the correlation, balance and
+ mid/side energies are derived from these three smoothed energies into the
+ same frames.
+
+ Nothing is allocated after construction and no lock is taken.
+ */
+class MeterCore
+{
+public:
+    struct ChannelSnapshot
+    {
+        float mPeak;
+        float mRMS;
+    };
+
+    struct ChannelFrame
+    {
+        /** The ballistic level. */
+        float mLevelDB;
+        /** The peak-hold marker. */
+        float mHoldDB;
+        float mRMSDB;
+    };
+
+    struct StereoPair
+    {
+        int mLeft;
+        int mRight;
+    };
+
+    struct PairFrame
+    {
+        /** Normalized cross product: 1 for mono, 0 for uncorrelated, -1 for out of phase. */
+        float mCorrelation;
+        /** Energy balance: -1 for left only, 1 for right only. */
+        float mBalance;
+        /** Energy of (L + R) / sqrt(2). */
+        float mMidDB;
+        /** Energy of (L - R) / sqrt(2). */
+        float mSideDB;
+    };
+
+    struct Frame
+    {
+        /** The number of blocks processed since the construction. */
+        uint64_t                  mBlockIndex;
+        std::vector<ChannelFrame> mChannels;
+        std::vector<PairFrame>    mPairs;
+    };
+
+    /**
+     @param pNumChannels The number of channels.
+     @param pSampleRate The sample rate, in Hz.
+     @param pRMSTime The time constant of the RMS average, in seconds.
+     @param pBallistics The dynamic response of the levels in the frames.
+     @param pStereoPairs The channel pairs to compute the stereo values of.
+     */
+    MeterCore(int pNumChannels, double pSampleRate, double pRMSTime = 0.3,
+              const MeterBallistics& pBallistics = MeterBallistics::digital(),
+              const std::vector<StereoPair>& pStereoPairs = std::vector<StereoPair>())
+    : mNumChannels(pNumChannels)
+    , mSampleRate(pSampleRate)
+    , mRMSTime(pRMSTime)
+    , mBallistics(pBallistics)
+    , mPeaks(new std::atomic<float>[(size_t)pNumChannels])
+    , mRMS(new std::atomic<float>[(size_t)pNumChannels])
+    , mMeanSquares((size_t)pNumChannels)
+    , mLevels((size_t)pNumChannels)
+    , mHolds((size_t)pNumChannels)
+    , mHoldTimes((size_t)pNumChannels)
+    , mBlockPeaks((size_t)pNumChannels)
+    , mBlockSumsOfSquares((size_t)pNumChannels)
+    , mPairLefts(pStereoPairs.size())
+    , mPairRights(pStereoPairs.size())
+    , mCrossProducts(pStereoPairs.size())
+    , mBlockCrossProducts(pStereoPairs.size())
+    , mBlockIndex(0)
+    , mFrames(Frame{0, std::vector<ChannelFrame>((size_t)pNumChannels, ChannelFrame{-144.f, -144.f, -144.f}),
+                    std::vector<PairFrame>(pStereoPairs.size(), PairFrame{0.f, 0.f, -144.f, -144.f})})
+    {
+        for (size_t p = 0 ; p != pStereoPairs.size() ; ++p)
+        {
+            assert(pStereoPairs[p].mLeft < pNumChannels && pStereoPairs[p].mRight < pNumChannels);
+            mPairLefts[p] = pStereoPairs[p].mLeft;
+            mPairRights[p] = pStereoPairs[p].mRight;
+        }
+        reset();
+    }
+
+    int getNumChannels() const
+    {
+        return mNumChannels;
+    }
+
+    double getSampleRate() const
+    {
+        return mSampleRate;
+    }
+
+    int getNumStereoPairs() const
+    {
+        return (int)mPairLefts.size();
+    }
+
+    const MeterBallistics& getBallistics() const
+    {
+        return mBallistics;
+    }
+
+    /**
+     Call from the audio thread, or when it is stopped.
+     */
+    void setBallistics(const MeterBallistics& pBallistics)
+    {
+        mBallistics = pBallistics;
+    }
+
+    /**
+     Call from the audio thread, or when it is stopped.
+     */
+    void reset()
+    {
+        for (int c = 0 ; c != mNumChannels ; ++c)
+        {
+            mPeaks[(size_t)c].store(0.f, std::memory_order_relaxed);
+            mRMS[(size_t)c].store(0.f, std::memory_order_relaxed);
+        }
+        std::fill(mMeanSquares.begin(), mMeanSquares.end(), 0.f);
+        std::fill(mLevels.begin(), mLevels.end(), 0.f);
+        std::fill(mHolds.begin(), mHolds.end(), 0.f);
+        std::fill(mHoldTimes.begin(), mHoldTimes.end(), 0.f);
+        std::fill(mCrossProducts.begin(), mCrossProducts.end(), 0.f);
+    }
+
+    /**
+     Audio thread: meter one block of planar channels.
+     */
+    void process(const float* const* pChannels, int pNumSamples)
+    {
+        if (pNumSamples <= 0)
+        {
+            return;
+        }
+        const BlockCoefficients lCoefficients = getBlockCoefficients(pNumSamples);
+        const float lInvNumSamples = 1.f / (float)pNumSamples;
+        Frame& lFrame = mFrames.getWriteBuffer();
+        for (int c = 0 ; c != mNumChannels ; ++c)
+        {
+            float lPeak;
+            float lSumOfSquares;
+            vectPeakAndSumOfSquares(pChannels[c], (size_t)pNumSamples, lPeak, lSumOfSquares);
+            publish(c, lPeak, lSumOfSquares * lInvNumSamples, lCoefficients, lFrame);
+        }
+        for (size_t p = 0 ; p != mPairLefts.size() ; ++p)
+        {
+            float lCrossProduct = vectDotProduct(pChannels[mPairLefts[p]], pChannels[mPairRights[p]], (size_t)pNumSamples);
+            publishPair(p, lCrossProduct * lInvNumSamples, lCoefficients, lFrame);
+        }
+        publishFrame(lFrame);
+    }
+
+    /**
+     Audio thread: meter one block of interleaved channels, in a single pass
+     over the buffer.
+     */
+    void processInterleaved(const float* pInterleaved, int pNumFrames)
+    {
+        if (pNumFrames <= 0)
+        {
+            return;
+        }
+        std::fill(mBlockPeaks.begin(), mBlockPeaks.end(), 0.f);
+        std::fill(mBlockSumsOfSquares.begin(), mBlockSumsOfSquares.end(), 0.f);
+        std::fill(mBlockCrossProducts.begin(), mBlockCrossProducts.end(), 0.f);
+        // the cross products read each tile again while it is in L1
+        const size_t C = (size_t)mNumChannels;
+        for (int lStart = 0 ; lStart < pNumFrames ; lStart += kTileSize)
+        {
+            const float* lTile = pInterleaved + (size_t)lStart * C;
+            const size_t lNumFrames = (size_t)std::min((int)kTileSize, pNumFrames - lStart);
+            vectInterleavedPeakAndSumOfSquares(lTile, C, lNumFrames, mBlockPeaks.data(), mBlockSumsOfSquares.data());
+            vectInterleavedCrossProducts(lTile, C, lNumFrames, mPairLefts.data(), mPairRights.data(),
+                                         mPairLefts.size(), mBlockCrossProducts.data());
+        }
+        const BlockCoefficients lCoefficients = getBlockCoefficients(pNumFrames);
+        const float lInvNumSamples = 1.f / (float)pNumFrames;
+        Frame& lFrame = mFrames.getWriteBuffer();
+        for (int c = 0 ; c != mNumChannels ; ++c)
+        {
+            publish(c, mBlockPeaks[(size_t)c], mBlockSumsOfSquares[(size_t)c] * lInvNumSamples, lCoefficients, lFrame);
+        }
+        for (size_t p = 0 ; p != mPairLefts.size() ; ++p)
+        {
+            publishPair(p, mBlockCrossProducts[p] * lInvNumSamples, lCoefficients, lFrame);
+        }
+        publishFrame(lFrame);
+    }
+
+    /**
+     Any thread: read the values of the first pNumChannels channels.
+     @param pResetPeaks Whether to reset the peaks, so that the next snapshot
+     holds the peaks since this one.
+     */
+    void getSnapshot(ChannelSnapshot* pOut, int pNumChannels, bool pResetPeaks = true)
+    {
+        assert(pNumChannels <= mNumChannels);
+        for (int c = 0 ; c != pNumChannels ; ++c)
+        {
+            std::atomic<float>& lPeak = mPeaks[(size_t)c];
+            pOut[c].mPeak = pResetPeaks ? lPeak.exchange(0.f, std::memory_order_relaxed)
+                                        : lPeak.load(std::memory_order_relaxed);
+            pOut[c].mRMS = mRMS[(size_t)c].load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     One reader thread: fetch the latest frame.
+     @return whether a block was processed since the last call.
+     */
+    bool updateFrame()
+    {
+        return mFrames.update();
+    }
+
+    /**
+     One reader thread: the frame fetched by the last updateFrame().
+     */
+    const Frame& getFrame() const
+    {
+        return mFrames.getReadBuffer();
+    }
+
+    /**
+     Amplitude to dB, with the -144 dB floor of SimpleMeter.
+     */
+    static float toDB(float pAmplitude)
+    {
+        return pAmplitude > 6.30957344e-8f ? 20.f * std::log10(pAmplitude) : -144.f;
+    }
+
+private:
+    static constexpr int kTileSize = 64;
+
+    struct BlockCoefficients
+    {
+        float mRMS;
+        float mAttack;
+        float mRelease;
+        float mDuration;
+    };
+
+    BlockCoefficients getBlockCoefficients(int pNumSamples) const
+    {
+        const double lDuration = (double)pNumSamples / mSampleRate;
+        BlockCoefficients lCoefficients;
+        lCoefficients.mRMS = onePoleCoefficient(lDuration, mRMSTime);
+        lCoefficients.mAttack = onePoleCoefficient(lDuration, mBallistics.mAttackTime);
+        // the constant dB fall is a gain per block
+        lCoefficients.mRelease = mBallistics.mReleaseRate > 0.f
+            ? (float)std::pow(10., -mBallistics.mReleaseRate * lDuration / 20.)
+            : onePoleCoefficient(lDuration, mBallistics.mReleaseTime);
+        lCoefficients.mDuration = (float)lDuration;
+        return lCoefficients;
+    }
+
+    static float onePoleCoefficient(double pDuration, double pTime)
+    {
+        return pTime > 0. ? (float)(1. - std::exp(-pDuration / pTime)) : 1.f;
+    }
+
+    void publish(int pChannel, float pPeak, float pMeanSquare, const BlockCoefficients& pCoefficients, Frame& pFrame)
+    {
+        const size_t c = (size_t)pChannel;
+        atomicMax(mPeaks[c], pPeak);
+        float& lMeanSquare = mMeanSquares[c];
+        lMeanSquare += pCoefficients.mRMS * (pMeanSquare - lMeanSquare);
+        const float lRMS = std::sqrt(lMeanSquare);
+        mRMS[c].store(lRMS, std::memory_order_relaxed);
+
+        // ballistics
+        const float lInput = mBallistics.mDetector == MeterBallistics::Detector::Peak ? pPeak : std::sqrt(pMeanSquare);
+        float& lLevel = mLevels[c];
+        if (lInput > lLevel)
+        {
+            lLevel += pCoefficients.mAttack * (lInput - lLevel);
+        }
+        else if (mBallistics.mReleaseRate > 0.f)
+        {
+            lLevel = std::max(lInput, lLevel * pCoefficients.mRelease);
+        }
+        else
+        {
+            lLevel += pCoefficients.mRelease * (lInput - lLevel);
+        }
+        float& lHold = mHolds[c];
+        float& lHoldTime = mHoldTimes[c];
+        if (mBallistics.mPeakHoldTime <= 0.f)
+        {
+            lHold = lLevel;
+        }
+        else if (pPeak >= lHold)
+        {
+            lHold = pPeak;
+            lHoldTime = mBallistics.mPeakHoldTime;
+        }
+        else
+        {
+            lHoldTime -= pCoefficients.mDuration;
+            if (lHoldTime <= 0.f)
+            {
+                lHold = lLevel;
+            }
+        }
+
+        ChannelFrame& lFrame = pFrame.mChannels[c];
+        lFrame.mLevelDB = toDB(lLevel);
+        lFrame.mHoldDB = toDB(std::max(lHold, lLevel));
+        lFrame.mRMSDB = toDB(lRMS);
+    }
+
+    /**
+     After the mean squares of the block were updated.
+     */
+    void publishPair(size_t pPair, float pCrossProduct, const BlockCoefficients& pCoefficients, Frame& pFrame)
+    {
+        float& lCrossProduct = mCrossProducts[pPair];
+        lCrossProduct += pCoefficients.mRMS * (pCrossProduct - lCrossProduct);
+        const float lLeft = mMeanSquares[(size_t)mPairLefts[pPair]];
+        const float lRight = mMeanSquares[(size_t)mPairRights[pPair]];
+        const float lSum = lLeft + lRight;
+        const float lProduct = lLeft * lRight;
+
+        PairFrame& lFrame = pFrame.mPairs[pPair];
+        lFrame.mCorrelation = lProduct > 1e-20f
+            ? std::max(-1.f, std::min(1.f, lCrossProduct / std::sqrt(lProduct)))
+            : 0.f;
+        lFrame.mBalance = lSum > 1e-20f ? (lRight - lLeft) / lSum : 0.f;
+        // M = (L + R) / sqrt(2) and S = (L - R) / sqrt(2)
+        lFrame.mMidDB = toDB(std::sqrt(std::max(0.5f * lSum + lCrossProduct, 0.f)));
+        lFrame.mSideDB = toDB(std::sqrt(std::max(0.5f * lSum - lCrossProduct, 0.f)));
+    }
+
+    void publishFrame(Frame& pFrame)
+    {
+        pFrame.mBlockIndex = ++mBlockIndex;
+        mFrames.publish();
+    }
+
+    int                                   mNumChannels;
+    double                                mSampleRate;
+    double                                mRMSTime;
+    MeterBallistics                       mBallistics;
+    std::unique_ptr<std::atomic<float>[]> mPeaks;
+    std::unique_ptr<std::atomic<float>[]> mRMS;
+    // audio thread state
+    std::vector<float>                    mMeanSquares;
+    std::vector<float>                    mLevels;
+    std::vector<float>                    mHolds;
+    std::vector<float>                    mHoldTimes;
+    std::vector<float>                    mBlockPeaks;
+    std::vector<float>                    mBlockSumsOfSquares;
+    std::vector<int>                      mPairLefts;
+    std::vector<int>                      mPairRights;
+    std::vector<float>                    mCrossProducts;
+    std::vector<float>                    mBlockCrossProducts;
+    uint64_t                              mBlockIndex;
+    TripleBuffer<Frame>                   mFrames;
+};
+
+}
+
+#endif
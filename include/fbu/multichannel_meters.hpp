@@ -30,8 +30,38 @@ SOFTWARE.
 
 #include "JuceHeader.h"
 
+#include "fbu/meter_core.hpp"
 #include "fbu/simple_meter.hpp"
 
+#include <vector>
+
+// The channel labels, shared by MultichannelMeters and BatchedMultichannelMeters.
+namespace fbu_multichannel_meters
+{
+    inline void addLabel(Component& pParent, OwnedArray<Label>& pLabels)
+    {
+        Label* lLabel = new Label();
+        pParent.addAndMakeVisible(lLabel);
+        lLabel->setJustificationType(Justification::centred);
+        lLabel->setEditable(false, false, false);
+        lLabel->setColour(Label::textColourId, Colour(0xffa0a0a0));
+        lLabel->setBorderSize(BorderSize<int>(0, 0, 0, 0));
+        pLabels.add(lLabel);
+    }
+    
+    inline void setLabelTexts(OwnedArray<Label>& pLabels, const char* const * pTexts)
+    {
+        int i = 0;
+        for (Label* lLabel : pLabels)
+        {
+            lLabel->setText(pTexts[i], dontSendNotification);
+            lLabel->setMinimumHorizontalScale(0.01f);
+            lLabel->setTooltip(pTexts[i]);
+            ++i;
+        }
+    }
+}
+
 class MultichannelMeters
 : public Component
 , private Timer
@@ -66,12 +96,7 @@ public:
                 lSMC->setForegroundColour(Colours::grey);
                 mMeterComponents.add(lSMC);
                 
-                Label* lLabel = new Label();
-                addAndMakeVisible(lLabel);
-                lLabel->setJustificationType(Justification::centred);
-                lLabel->setEditable(false, false, false);
-                lLabel->setColour(Label::textColourId, Colour(0xffa0a0a0));
-                mMeterLabels.add(lLabel);
+                fbu_multichannel_meters::addLabel(*this, mMeterLabels);
             }
             
             // Shrink
@@ -91,7 +116,6 @@ public:
             i = 0;
             for (Label* lLabel : mMeterLabels)
             {
-                lLabel->setBorderSize(BorderSize<int>(0, 0, 0, 0));
                 lLabel->setBounds(getWidth()/2 - pNumChannels * 5 - 1 + i * 10, 144/5 + 4, 11, 18);
                 ++i;
             }
@@ -104,15 +128,8 @@ public:
      */
     void updateLabels(const char* const * pLabels)
     {
+        fbu_multichannel_meters::setLabelTexts(mMeterLabels, pLabels);
         int i = 0;
-        for (Label* lLabel : mMeterLabels)
-        {
-            lLabel->setText(pLabels[i], dontSendNotification);
-            lLabel->setMinimumHorizontalScale(0.01f);
-            lLabel->setTooltip(pLabels[i]);
-            ++i;
-        }
-        i = 0;
         for (SimpleMeterComponent* lSMC : mMeterComponents)
         {
             lSMC->setTooltip(pLabels[i]);
@@ -137,5 +154,192 @@ private:
     OwnedArray<Label>                mMeterLabels;
 };
 
-#endif
+//==============================================================================
+/**
+ @class BatchedMultichannelMeters
+ @brief The layout of MultichannelMeters, drawn by a single component from the
+ frames of a fbu::MeterCore instead of one SimpleMeterComponent per channel.
+
+ The timer only fetches the latest frame and converts it to bar heights
+ through a dB-to-pixel table built on resize, with the same skew as
+ SimpleMeterComponent. It repaints nothing when no block was processed, and
+ otherwise only the strips of the meters whose heights changed: JUCE gathers
+ them into one paint call, which draws the cached background and plain
+ rectangles for the bars and peak-hold markers in the clip region.
 
+ This component is the reader of the MeterCore frames: nothing else should
+ call updateFrame() on it.
+ */
+class BatchedMultichannelMeters
+: public Component
+, private Timer
+{
+public:
+    BatchedMultichannelMeters(fbu::MeterCore& pMeterCore, int pHz = 0)
+    : Component()
+    , Timer()
+    , mMeterCore(pMeterCore)
+    , mLevelHeights((size_t)pMeterCore.getNumChannels(), 0)
+    , mHoldHeights((size_t)pMeterCore.getNumChannels(), 0)
+    , mForegroundColour(Colours::grey)
+    , mBackgroundColour(Colours::black)
+    {
+        for (int i = 0 ; i != getNumMeters() ; ++i)
+        {
+            fbu_multichannel_meters::addLabel(*this, mMeterLabels);
+        }
+        startTimerHz(pHz);
+    }
+    
+    ~BatchedMultichannelMeters()
+    {
+        stopTimer();
+    }
+    
+    int getNumMeters() const
+    {
+        return mMeterCore.getNumChannels();
+    }
+    
+    void setForegroundColour(Colour pColour)
+    {
+        mForegroundColour = pColour;
+        repaint();
+    }
+    
+    void setBackgroundColour(Colour pColour)
+    {
+        mBackgroundColour = pColour;
+        updateBackground();
+        repaint();
+    }
+    
+    /**
+     Call this with an array of strings that is greater or equal to the number
+     of meters.
+     */
+    void updateLabels(const char* const * pLabels)
+    {
+        fbu_multichannel_meters::setLabelTexts(mMeterLabels, pLabels);
+    }
+    
+    void resized() override
+    {
+        const int lNumMeters = getNumMeters();
+        mMetersX = getWidth()/2 - lNumMeters * 5 + 2;
+        int i = 0;
+        for (Label* lLabel : mMeterLabels)
+        {
+            lLabel->setBounds(mMetersX - 3 + i * 10, kMeterHeight + 4, 11, 18);
+            ++i;
+        }
+        
+        // dB to pixels, as in SimpleMeterComponent
+        mHeightTable.resize(kTableSize);
+        for (int t = 0 ; t != kTableSize ; ++t)
+        {
+            float lNormalizedDB = (float)t / (float)(kTableSize - 1);
+            mHeightTable[(size_t)t] = roundToInt(std::pow(lNormalizedDB, 4.f) * (float)kMeterHeight);
+        }
+        updateBackground();
+        repaint();
+    }
+    
+    /**
+     This can be called directly if this component has been intantiated with a
+     refresh rate of 0
+     */
+    void timerCallback() override
+    {
+        if (!mMeterCore.updateFrame() || mHeightTable.empty())
+        {
+            return;
+        }
+        const fbu::MeterCore::Frame& lFrame = mMeterCore.getFrame();
+        for (int i = 0 ; i != getNumMeters() ; ++i)
+        {
+            const fbu::MeterCore::ChannelFrame& lChannel = lFrame.mChannels[(size_t)i];
+            int lLevel = dbToHeight(lChannel.mLevelDB);
+            int lHold = std::max(dbToHeight(lChannel.mHoldDB), lLevel);
+            int& lOldLevel = mLevelHeights[(size_t)i];
+            int& lOldHold = mHoldHeights[(size_t)i];
+            if (lLevel == lOldLevel && lHold == lOldHold)
+            {
+                continue;
+            }
+            // the rows between the lowest and highest changed edges, hold marker included
+            int lTop = std::max(std::max(lHold, lOldHold), std::max(lLevel, lOldLevel)) + 1;
+            int lBottom = std::min(std::min(lHold, lOldHold), std::min(lLevel, lOldLevel)) - 1;
+            lOldLevel = lLevel;
+            lOldHold = lHold;
+            repaint(getMeterBounds(i).withTop(kMeterHeight - lTop).withBottom(kMeterHeight - std::max(lBottom, 0)));
+        }
+    }
+    
+private:
+    static constexpr int kMeterWidth = 5;
+    static constexpr int kMeterHeight = 144/5;
+    static constexpr int kStepsPerDB = 4;
+    static constexpr int kTableSize = 144 * kStepsPerDB + 1;
+    
+    Rectangle<int> getMeterBounds(int pMeter) const
+    {
+        return Rectangle<int>(mMetersX + pMeter * 10, 0, kMeterWidth, kMeterHeight);
+    }
+    
+    int dbToHeight(float pDB) const
+    {
+        int lIndex = roundToInt((pDB + 144.f) * (float)kStepsPerDB);
+        return mHeightTable[(size_t)jlimit(0, kTableSize - 1, lIndex)];
+    }
+    
+    void updateBackground()
+    {
+        if (getWidth() <= 0 || getHeight() <= 0)
+        {
+            return;
+        }
+        mBackground = Image(Image::ARGB, getWidth(), kMeterHeight, true);
+        Graphics g(mBackground);
+        g.setFillType(mBackgroundColour);
+        for (int i = 0 ; i != getNumMeters() ; ++i)
+        {
+            g.fillRoundedRectangle(getMeterBounds(i).toFloat(), kMeterWidth/2);
+        }
+    }
+    
+    void paint(Graphics& g) override
+    {
+        g.drawImageAt(mBackground, 0, 0);
+        g.setColour(mForegroundColour);
+        for (int i = 0 ; i != getNumMeters() ; ++i)
+        {
+            Rectangle<int> lBounds = getMeterBounds(i);
+            if (!g.clipRegionIntersects(lBounds))
+            {
+                continue;
+            }
+            int lLevel = mLevelHeights[(size_t)i];
+            int lHold = mHoldHeights[(size_t)i];
+            g.fillRect(lBounds.getX(), kMeterHeight - lLevel, kMeterWidth, lLevel);
+            if (lHold > lLevel)
+            {
+                g.fillRect(lBounds.getX(), kMeterHeight - lHold, kMeterWidth, 1);
+            }
+        }
+    }
+    
+    fbu::MeterCore&  mMeterCore;
+    OwnedArray<Label> mMeterLabels;
+    std::vector<int> mHeightTable;
+    std::vector<int> mLevelHeights;
+    std::vector<int> mHoldHeights;
+    Image            mBackground;
+    int              mMetersX = 0;
+    Colour           mForegroundColour;
+    Colour           mBackgroundColour;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BatchedMultichannelMeters);
+};
+
+#endif
@@ -0,0 +1,277 @@
+#ifndef FBU_QUATERNION_HPP_INCLUDED
+#define FBU_QUATERNION_HPP_INCLUDED
+
+/**
+ @file quaternion.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/matrix3.hpp"
+#include "fbu/vector3.hpp"
+
+#include <cmath>
+#include <cassert>
+#include <cstddef>
+
+//==============================================================================
+/**
+ @brief A POD rotation quaternion (w + xi + yj + zk).
+
+ Yaw, pitch and roll follow the same conventions as Matrix3.
+ */
+template <typename T>
+struct Quaternion
+{
+    T mW;
+    T mX;
+    T mY;
+    T mZ;
+
+    static Quaternion<T> identity()
+    {
+        return {(T)1, (T)0, (T)0, (T)0};
+    }
+
+    /**
+     Rotation of pAngle (rad) around the normalized axis pAxis, right-handed.
+     */
+    static Quaternion<T> fromAxisAngle(const Vector3<T>& pAxis, T pAngle)
+    {
+        T lHalfSin = std::sin((T)0.5 * pAngle);
+        return {std::cos((T)0.5 * pAngle),
+                lHalfSin * pAxis.mX,
+                lHalfSin * pAxis.mY,
+                lHalfSin * pAxis.mZ};
+    }
+
+    static Quaternion<T> fromYawPitchRoll(T pYaw, T pPitch, T pRoll)
+    {
+        // qz(yaw) * qy(-pitch) * qx(roll)
+        T cy = std::cos((T)0.5 * pYaw);
+        T sy = std::sin((T)0.5 * pYaw);
+        T cp = std::cos((T)0.5 * pPitch);
+        T sp = - std::sin((T)0.5 * pPitch);
+        T cr = std::cos((T)0.5 * pRoll);
+        T sr = std::sin((T)0.5 * pRoll);
+        return {cy * cp * cr + sy * sp * sr,
+                cy * cp * sr - sy * sp * cr,
+                cy * sp * cr + sy * cp * sr,
+                sy * cp * cr - cy * sp * sr};
+    }
+
+    static Quaternion<T> fromMatrix3(const Matrix3<T>& pM)
+    {
+        const T (&m)[3][3] = pM.m;
+        T lTrace = m[0][0] + m[1][1] + m[2][2];
+        Quaternion<T> q;
+        if (lTrace > (T)0)
+        {
+            T s = (T)2 * std::sqrt(lTrace + (T)1);
+            q.mW = (T)0.25 * s;
+            q.mX = (m[2][1] - m[1][2]) / s;
+            q.mY = (m[0][2] - m[2][0]) / s;
+            q.mZ = (m[1][0] - m[0][1]) / s;
+        }
+        else if (m[0][0] > m[1][1] && m[0][0] > m[2][2])
+        {
+            T s = (T)2 * std::sqrt((T)1 + m[0][0] - m[1][1] - m[2][2]);
+            q.mW = (m[2][1] - m[1][2]) / s;
+            q.mX = (T)0.25 * s;
+            q.mY = (m[0][1] + m[1][0]) / s;
+            q.mZ = (m[0][2] + m[2][0]) / s;
+        }
+        else if (m[1][1] > m[2][2])
+        {
+            T s = (T)2 * std::sqrt((T)1 + m[1][1] - m[0][0] - m[2][2]);
+            q.mW = (m[0][2] - m[2][0]) / s;
+            q.mX = (m[0][1] + m[1][0]) / s;
+            q.mY = (T)0.25 * s;
+            q.mZ = (m[1][2] + m[2][1]) / s;
+        }
+        else
+        {
+            T s = (T)2 * std::sqrt((T)1 + m[2][2] - m[0][0] - m[1][1]);
+            q.mW = (m[1][0] - m[0][1]) / s;
+            q.mX = (m[0][2] + m[2][0]) / s;
+            q.mY = (m[1][2] + m[2][1]) / s;
+            q.mZ = (T)0.25 * s;
+        }
+        return q;
+    }
+
+    /**
+     The conjugate is the inverse rotation for a normalized quaternion.
+     */
+    Quaternion<T> conj() const
+    {
+        return {mW, -mX, -mY, -mZ};
+    }
+
+    T dot(const Quaternion<T>& pOther) const
+    {
+        return mW * pOther.mW + mX * pOther.mX + mY * pOther.mY + mZ * pOther.mZ;
+    }
+
+    T sqrNorm() const
+    {
+        return dot(*this);
+    }
+
+    T norm() const
+    {
+        return std::sqrt(sqrNorm());
+    }
+
+    void normalize()
+    {
+        T lSqrNorm = sqrNorm();
+        assert(lSqrNorm != (T)0);
+        T lInvNorm = mu::finvsqrt(lSqrNorm);
+        mW *= lInvNorm;
+        mX *= lInvNorm;
+        mY *= lInvNorm;
+        mZ *= lInvNorm;
+    }
+
+    Quaternion<T> normalized() const
+    {
+        Quaternion<T> lQ(*this);
+        lQ.normalize();
+        return lQ;
+    }
+
+    /**
+     Rotate a vector, assuming the quaternion is normalized.
+     v' = v + w.t + q x t, with t = 2 (q x v)
+     */
+    Vector3<T> rotate(const Vector3<T>& pV) const
+    {
+        T tx = (T)2 * (mY * pV.mZ - mZ * pV.mY);
+        T ty = (T)2 * (mZ * pV.mX - mX * pV.mZ);
+        T tz = (T)2 * (mX * pV.mY - mY * pV.mX);
+        return {pV.mX + mW * tx + mY * tz - mZ * ty,
+                pV.mY + mW * ty + mZ * tx - mX * tz,
+                pV.mZ + mW * tz + mX * ty - mY * tx};
+    }
+
+    AEM<T> rotate(const AEM<T>& pAEM) const
+    {
+        return AEM<T>::fromVector3(rotate(Vector3<T>::fromAEM(pAEM)));
+    }
+
+    AE<T> rotate(const AE<T>& pAE) const
+    {
+        return AE<T>::fromNormalizedVector3(rotate(Vector3<T>::fromAE(pAE)).normalized());
+    }
+
+    Matrix3<T> toMatrix3() const
+    {
+        T xx = mX * mX, yy = mY * mY, zz = mZ * mZ;
+        T xy = mX * mY, xz = mX * mZ, yz = mY * mZ;
+        T wx = mW * mX, wy = mW * mY, wz = mW * mZ;
+        return {{{(T)1 - (T)2 * (yy + zz), (T)2 * (xy - wz),         (T)2 * (xz + wy)},
+                 {(T)2 * (xy + wz),         (T)1 - (T)2 * (xx + zz), (T)2 * (yz - wx)},
+                 {(T)2 * (xz - wy),         (T)2 * (yz + wx),         (T)1 - (T)2 * (xx + yy)}}};
+    }
+
+    void toYawPitchRoll(T& pYaw, T& pPitch, T& pRoll) const
+    {
+        toMatrix3().toYawPitchRoll(pYaw, pPitch, pRoll);
+    }
+
+    /**
+     Spherical linear interpolation along the shortest path. Falls back to a
+     normalized linear interpolation when both rotations are very close.
+     */
+    static Quaternion<T> slerp(const Quaternion<T>& pA, const Quaternion<T>& pB, T pT)
+    {
+        Quaternion<T> lB(pB);
+        T lCos = pA.dot(pB);
+        if (lCos < (T)0)
+        {
+            lCos = -lCos;
+            lB = {-pB.mW, -pB.mX, -pB.mY, -pB.mZ};
+        }
+        T lWeightA;
+        T lWeightB;
+        if (lCos > (T)0.9995)
+        {
+            lWeightA = (T)1 - pT;
+            lWeightB = pT;
+        }
+        else
+        {
+            T lAngle = std::acos(lCos);
+            T lInvSin = (T)1 / std::sin(lAngle);
+            lWeightA = std::sin(((T)1 - pT) * lAngle) * lInvSin;
+            lWeightB = std::sin(pT * lAngle) * lInvSin;
+        }
+        Quaternion<T> lResult = {lWeightA * pA.mW + lWeightB * lB.mW,
+                                 lWeightA * pA.mX + lWeightB * lB.mX,
+                                 lWeightA * pA.mY + lWeightB * lB.mY,
+                                 lWeightA * pA.mZ + lWeightB * lB.mZ};
+        lResult.normalize();
+        return lResult;
+    }
+};
+
+/**
+ Hamilton product: (pA * pB) applies pB first, then pA.
+ */
+template <typename T>
+Quaternion<T> operator *(const Quaternion<T>& pA, const Quaternion<T>& pB)
+{
+    return {pA.mW * pB.mW - pA.mX * pB.mX - pA.mY * pB.mY - pA.mZ * pB.mZ,
+            pA.mW * pB.mX + pA.mX * pB.mW + pA.mY * pB.mZ - pA.mZ * pB.mY,
+            pA.mW * pB.mY - pA.mX * pB.mZ + pA.mY * pB.mW + pA.mZ * pB.mX,
+            pA.mW * pB.mZ + pA.mX * pB.mY - pA.mY * pB.mX + pA.mZ * pB.mW};
+}
+
+template <typename T>
+Vector3<T> operator *(const Quaternion<T>& pQ, const Vector3<T>& pV)
+{
+    return pQ.rotate(pV);
+}
+
+typedef Quaternion<float> Quaternionf;
+
+//==============================================================================
+/**
+ Batch rotation by a quaternion: the quaternion is converted once to a matrix,
+ so that each vector costs 9 multiply-adds.
+ */
+template <typename T>
+void vectRotate(const Quaternion<T>& pQ, const Vector3<T>* __restrict pIn, Vector3<T>* __restrict pOut, size_t pSize)
+{
+    vectRotate(pQ.toMatrix3(), pIn, pOut, pSize);
+}
+
+template <typename T>
+void vectRotate_I(const Quaternion<T>& pQ, Vector3<T>* pInOut, size_t pSize)
+{
+    vectRotate_I(pQ.toMatrix3(), pInOut, pSize);
+}
+
+#endif
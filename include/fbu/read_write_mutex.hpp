@@ -35,6 +35,8 @@ SOFTWARE.
 #endif
 
 #include <mutex>
+#include <condition_variable>
+#include <cassert>
 #include <atomic>
 
 namespace fbu
@@ -50,14 +50,11 @@ void SimpleMeter::process(const float* pBuffer, int pNumSamples)
         // TODO: PEAK FLASH
     }
     
-    bool lWasZero = mPeak.compareAndSetBool(lCurrentPeak, 0.f);
-    if (!lWasZero)
+    // CAS loop: a concurrent getPeakAmplitudeAndReset() cannot lose the peak
+    float lPreviousPeak = mPeak.get();
+    while (lPreviousPeak < lCurrentPeak && !mPeak.compareAndSetBool(lCurrentPeak, lPreviousPeak))
     {
-        float lPreviousPeak = mPeak.get();
-        if (lPreviousPeak < lCurrentPeak)
-        {
-            mPeak.set(lCurrentPeak);
-        }
+        lPreviousPeak = mPeak.get();
     }
     
     //std::cerr << mName.toRawUTF8() << ":" << mPeak.get() << std::endl;
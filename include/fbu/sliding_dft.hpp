@@ -0,0 +1,279 @@
+#ifndef FBU_SLIDING_DFT_HPP_INCLUDED
+#define FBU_SLIDING_DFT_HPP_INCLUDED
+
+/**
+ @file sliding_dft.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/complex.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ @class SlidingDFT
+ @brief DFT values of the last N samples at an arbitrary set of frequencies,
+ updated every sample.
+
+ For each frequency w, X(n) = sum over j in [0, N) of r^j.x[n-j].e^(i.w.j),
+ with the phase referenced to the newest sample, is updated as
+ X(n) = x[n] - r^N.e^(i.w.N).x[n-N] + r.e^(i.w).X(n-1), which holds for any
+ frequency, not only bin centers. The state is stored as separate real and
+ imaginary arrays and every sample runs one loop over the frequencies, which
+ the compiler vectorizes.
+
+ With r = 1 the window is rectangular but rounding errors are never damped;
+ a damping r slightly below 1 (e.g. 0.99999) keeps the recursion stable for
+ long runs in float.
+ */
+template <typename T>
+class SlidingDFT
+{
+public:
+    /**
+     @param pWindowSize N, in samples.
+     @param pFrequencies The frequencies in cycles per sample (f / sample rate).
+     @param pNumFrequencies Their number.
+     @param pDamping r, in (0, 1].
+     */
+    SlidingDFT(size_t pWindowSize, const T* pFrequencies, size_t pNumFrequencies, T pDamping = (T)1)
+    : mWindowSize(pWindowSize)
+    , mHistory(pWindowSize)
+    , mARe(pNumFrequencies), mAIm(pNumFrequencies)
+    , mBRe(pNumFrequencies), mBIm(pNumFrequencies)
+    , mRe(pNumFrequencies), mIm(pNumFrequencies)
+    {
+        assert(pWindowSize >= 1 && pDamping > (T)0 && pDamping <= (T)1);
+        const double lDampingN = std::pow((double)pDamping, (double)pWindowSize);
+        for (size_t k = 0 ; k != pNumFrequencies ; ++k)
+        {
+            double w = 2. * M_PI * (double)pFrequencies[k];
+            mARe[k] = (T)((double)pDamping * std::cos(w));
+            mAIm[k] = (T)((double)pDamping * std::sin(w));
+            mBRe[k] = (T)(lDampingN * std::cos(w * (double)pWindowSize));
+            mBIm[k] = (T)(lDampingN * std::sin(w * (double)pWindowSize));
+        }
+        reset();
+    }
+
+    size_t getWindowSize() const
+    {
+        return mWindowSize;
+    }
+
+    size_t getNumFrequencies() const
+    {
+        return mRe.size();
+    }
+
+    void reset()
+    {
+        std::fill(mHistory.begin(), mHistory.end(), (T)0);
+        std::fill(mRe.begin(), mRe.end(), (T)0);
+        std::fill(mIm.begin(), mIm.end(), (T)0);
+        mHistoryPosition = 0;
+    }
+
+    void process(const T* pIn, size_t pNumSamples)
+    {
+        const size_t lNumFrequencies = getNumFrequencies();
+        const T* __restrict aRe = mARe.data();
+        const T* __restrict aIm = mAIm.data();
+        const T* __restrict bRe = mBRe.data();
+        const T* __restrict bIm = mBIm.data();
+        T* __restrict xRe = mRe.data();
+        T* __restrict xIm = mIm.data();
+        for (size_t i = 0 ; i != pNumSamples ; ++i)
+        {
+            const T x = pIn[i];
+            const T lOldest = mHistory[mHistoryPosition];
+            mHistory[mHistoryPosition] = x;
+            mHistoryPosition = mHistoryPosition + 1 == mWindowSize ? 0 : mHistoryPosition + 1;
+            for (size_t k = 0 ; k != lNumFrequencies ; ++k)
+            {
+                T lRe = x - bRe[k] * lOldest + aRe[k] * xRe[k] - aIm[k] * xIm[k];
+                T lIm = - bIm[k] * lOldest + aRe[k] * xIm[k] + aIm[k] * xRe[k];
+                xRe[k] = lRe;
+                xIm[k] = lIm;
+            }
+        }
+    }
+
+    Complex<T> getValue(size_t pIndex) const
+    {
+        return Complex<T>({mRe[pIndex], mIm[pIndex]});
+    }
+
+    void getValues(Complex<T>* pOut) const
+    {
+        for (size_t k = 0 ; k != getNumFrequencies() ; ++k)
+        {
+            pOut[k] = getValue(k);
+        }
+    }
+
+private:
+    size_t         mWindowSize;
+    std::vector<T> mHistory;
+    size_t         mHistoryPosition;
+    std::vector<T> mARe, mAIm;
+    std::vector<T> mBRe, mBIm;
+    std::vector<T> mRe, mIm;
+};
+
+//==============================================================================
+/**
+ @class GoertzelBank
+ @brief Goertzel filters at an arbitrary set of frequencies, giving the DFT
+ values X = sum over n in [0, N) of x[n].e^(-i.w.n) of consecutive blocks of
+ N samples.
+
+ Each frequency costs one multiply and two adds per sample: the recursion
+ s[n] = x[n] + 2.cos(w).s[n-1] - s[n-2] is run for all the frequencies at
+ once on separate state arrays, and the complex value is only formed at the
+ end of each block.
+ */
+template <typename T>
+class GoertzelBank
+{
+public:
+    /**
+     @param pBlockSize N, in samples.
+     @param pFrequencies The frequencies in cycles per sample (f / sample rate).
+     @param pNumFrequencies Their number.
+     */
+    GoertzelBank(size_t pBlockSize, const T* pFrequencies, size_t pNumFrequencies)
+    : mBlockSize(pBlockSize)
+    , mCoefficients(pNumFrequencies)
+    , mS1(pNumFrequencies), mS2(pNumFrequencies)
+    , mEndRe(pNumFrequencies), mEndIm(pNumFrequencies)
+    , mCosW(pNumFrequencies), mSinW(pNumFrequencies)
+    , mValues(pNumFrequencies)
+    {
+        assert(pBlockSize >= 1);
+        for (size_t k = 0 ; k != pNumFrequencies ; ++k)
+        {
+            double w = 2. * M_PI * (double)pFrequencies[k];
+            mCoefficients[k] = (T)(2. * std::cos(w));
+            mCosW[k] = (T)std::cos(w);
+            mSinW[k] = (T)std::sin(w);
+            // e^(-i.w.(N-1)), the phase of the last sample of the block
+            mEndRe[k] = (T)std::cos(w * (double)(pBlockSize - 1));
+            mEndIm[k] = (T)(- std::sin(w * (double)(pBlockSize - 1)));
+        }
+        reset();
+    }
+
+    size_t getBlockSize() const
+    {
+        return mBlockSize;
+    }
+
+    size_t getNumFrequencies() const
+    {
+        return mCoefficients.size();
+    }
+
+    void reset()
+    {
+        std::fill(mS1.begin(), mS1.end(), (T)0);
+        std::fill(mS2.begin(), mS2.end(), (T)0);
+        mPosition = 0;
+    }
+
+    /**
+     Process any number of samples.
+     @param pCallback Called at the end of each block as
+     pCallback(const Complex<T>* pValues, size_t pNumFrequencies).
+     */
+    template <class F>
+    void process(const T* pIn, size_t pNumSamples, F&& pCallback)
+    {
+        const size_t lNumFrequencies = getNumFrequencies();
+        const T* __restrict c = mCoefficients.data();
+        T* __restrict s1 = mS1.data();
+        T* __restrict s2 = mS2.data();
+        for (size_t i = 0 ; i != pNumSamples ; ++i)
+        {
+            const T x = pIn[i];
+            for (size_t k = 0 ; k != lNumFrequencies ; ++k)
+            {
+                T s = x + c[k] * s1[k] - s2[k];
+                s2[k] = s1[k];
+                s1[k] = s;
+            }
+            if (++mPosition == mBlockSize)
+            {
+                computeValues();
+                pCallback(getValues(), lNumFrequencies);
+                std::fill(mS1.begin(), mS1.end(), (T)0);
+                std::fill(mS2.begin(), mS2.end(), (T)0);
+                mPosition = 0;
+            }
+        }
+    }
+
+    /**
+     The values of the last complete block.
+     */
+    const Complex<T>* getValues() const
+    {
+        return mValues.data();
+    }
+
+private:
+    void computeValues()
+    {
+        for (size_t k = 0 ; k != getNumFrequencies() ; ++k)
+        {
+            // X = e^(-i.w.(N-1)).(s[N-1] - e^(-i.w).s[N-2])
+            Complex<T> y = {mS1[k] - mCosW[k] * mS2[k], mSinW[k] * mS2[k]};
+            mValues[k] = Complex<T>({mEndRe[k], mEndIm[k]}) * y;
+        }
+    }
+
+    size_t                    mBlockSize;
+    size_t                    mPosition;
+    std::vector<T>            mCoefficients;
+    std::vector<T>            mS1, mS2;
+    std::vector<T>            mEndRe, mEndIm;
+    std::vector<T>            mCosW, mSinW;
+    std::vector< Complex<T> > mValues;
+};
+
+typedef SlidingDFT<float> SlidingDFTf;
+typedef GoertzelBank<float> GoertzelBankf;
+
+}
+
+#endif
@@ -0,0 +1,581 @@
+#ifndef FBU_SPATIAL_INDEX_HPP_INCLUDED
+#define FBU_SPATIAL_INDEX_HPP_INCLUDED
+
+/**
+ @file spatial_index.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/vector3.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ @class KDTree
+ @brief A static 3-d tree over Vector3 points, for nearest, k-nearest and
+ radius queries in O(log n) on average.
+
+ The tree is built once (O(n log n)) and stored as a permutation of the point
+ indices: the node of a [begin, end) range is its middle element. Queries do
+ not allocate, except radius() which fills a std::vector.
+ */
+template <typename T>
+class KDTree
+{
+public:
+    KDTree()
+    {
+    }
+
+    KDTree(const Vector3<T>* pPoints, size_t pNumPoints)
+    {
+        build(pPoints, pNumPoints);
+    }
+
+    void build(const Vector3<T>* pPoints, size_t pNumPoints)
+    {
+        mPoints.assign(pPoints, pPoints + pNumPoints);
+        mIndices.resize(pNumPoints);
+        mAxes.assign(pNumPoints, 0);
+        for (size_t u = 0 ; u != pNumPoints ; ++u)
+        {
+            mIndices[u] = u;
+        }
+        buildRange(0, pNumPoints);
+    }
+
+    size_t size() const
+    {
+        return mPoints.size();
+    }
+
+    const Vector3<T>& getPoint(size_t pIndex) const
+    {
+        return mPoints[pIndex];
+    }
+
+    /**
+     Index of the nearest point, or size() if the tree is empty.
+     */
+    size_t nearest(const Vector3<T>& pQuery, T* pSqrDistance = nullptr) const
+    {
+        size_t lBest = mPoints.size();
+        T lBestSqrDistance = std::numeric_limits<T>::max();
+        nearestRange(pQuery, 0, mIndices.size(), lBest, lBestSqrDistance);
+        if (pSqrDistance)
+        {
+            *pSqrDistance = lBestSqrDistance;
+        }
+        return lBest;
+    }
+
+    /**
+     Find the pK nearest points, sorted by increasing distance.
+     @return the number of points found, which is min(pK, size()).
+     */
+    size_t kNearest(const Vector3<T>& pQuery, size_t pK, size_t* pIndices, T* pSqrDistances) const
+    {
+        size_t lFound = 0;
+        kNearestRange(pQuery, 0, mIndices.size(), pK, pIndices, pSqrDistances, lFound);
+        return lFound;
+    }
+
+    /**
+     Call pFunction(index, squaredDistance) for each point within pRadius.
+     */
+    template <class F>
+    void forEachInRadius(const Vector3<T>& pQuery, T pRadius, F&& pFunction) const
+    {
+        radiusRange(pQuery, pRadius * pRadius, 0, mIndices.size(), pFunction);
+    }
+
+    /**
+     Indices of the points within pRadius, in no particular order.
+     */
+    void radius(const Vector3<T>& pQuery, T pRadius, std::vector<size_t>& pIndices) const
+    {
+        pIndices.clear();
+        forEachInRadius(pQuery, pRadius, [&pIndices](size_t pIndex, T) { pIndices.push_back(pIndex); });
+    }
+
+    void nearestBatch(const Vector3<T>* pQueries, size_t pNumQueries, size_t* pIndices) const
+    {
+        for (size_t u = 0 ; u != pNumQueries ; ++u)
+        {
+            pIndices[u] = nearest(pQueries[u]);
+        }
+    }
+
+private:
+    static T coord(const Vector3<T>& pV, int pAxis)
+    {
+        return pAxis == 0 ? pV.mX : (pAxis == 1 ? pV.mY : pV.mZ);
+    }
+
+    void buildRange(size_t pBegin, size_t pEnd)
+    {
+        if (pEnd - pBegin <= 1)
+        {
+            return;
+        }
+        // split along the axis of largest spread
+        Vector3<T> lMin = mPoints[mIndices[pBegin]];
+        Vector3<T> lMax = lMin;
+        for (size_t u = pBegin + 1 ; u != pEnd ; ++u)
+        {
+            const Vector3<T>& p = mPoints[mIndices[u]];
+            lMin.mX = std::min(lMin.mX, p.mX); lMax.mX = std::max(lMax.mX, p.mX);
+            lMin.mY = std::min(lMin.mY, p.mY); lMax.mY = std::max(lMax.mY, p.mY);
+            lMin.mZ = std::min(lMin.mZ, p.mZ); lMax.mZ = std::max(lMax.mZ, p.mZ);
+        }
+        Vector3<T> lSpread = lMax - lMin;
+        int lAxis = 0;
+        if (lSpread.mY > lSpread.mX)
+        {
+            lAxis = 1;
+        }
+        if (lSpread.mZ > coord(lSpread, lAxis))
+        {
+            lAxis = 2;
+        }
+        size_t lMid = pBegin + (pEnd - pBegin) / 2;
+        const std::vector< Vector3<T> >& lPoints = mPoints;
+        std::nth_element(mIndices.begin() + (std::ptrdiff_t)pBegin,
+                         mIndices.begin() + (std::ptrdiff_t)lMid,
+                         mIndices.begin() + (std::ptrdiff_t)pEnd,
+                         [&lPoints, lAxis](size_t a, size_t b) {
+                             return coord(lPoints[a], lAxis) < coord(lPoints[b], lAxis);
+                         });
+        mAxes[lMid] = lAxis;
+        buildRange(pBegin, lMid);
+        buildRange(lMid + 1, pEnd);
+    }
+
+    void nearestRange(const Vector3<T>& pQuery, size_t pBegin, size_t pEnd, size_t& pBest, T& pBestSqrDistance) const
+    {
+        if (pBegin == pEnd)
+        {
+            return;
+        }
+        size_t lMid = pBegin + (pEnd - pBegin) / 2;
+        size_t lIndex = mIndices[lMid];
+        T lSqrDistance = (mPoints[lIndex] - pQuery).sqrLength();
+        if (lSqrDistance < pBestSqrDistance)
+        {
+            pBestSqrDistance = lSqrDistance;
+            pBest = lIndex;
+        }
+        int lAxis = mAxes[lMid];
+        T lDiff = coord(pQuery, lAxis) - coord(mPoints[lIndex], lAxis);
+        if (lDiff < (T)0)
+        {
+            nearestRange(pQuery, pBegin, lMid, pBest, pBestSqrDistance);
+            if (lDiff * lDiff < pBestSqrDistance)
+            {
+                nearestRange(pQuery, lMid + 1, pEnd, pBest, pBestSqrDistance);
+            }
+        }
+        else
+        {
+            nearestRange(pQuery, lMid + 1, pEnd, pBest, pBestSqrDistance);
+            if (lDiff * lDiff < pBestSqrDistance)
+            {
+                nearestRange(pQuery, pBegin, lMid, pBest, pBestSqrDistance);
+            }
+        }
+    }
+
+    void kNearestRange(const Vector3<T>& pQuery, size_t pBegin, size_t pEnd, size_t pK,
+                       size_t* pIndices, T* pSqrDistances, size_t& pFound) const
+    {
+        if (pBegin == pEnd || pK == 0)
+        {
+            return;
+        }
+        size_t lMid = pBegin + (pEnd - pBegin) / 2;
+        size_t lIndex = mIndices[lMid];
+        T lSqrDistance = (mPoints[lIndex] - pQuery).sqrLength();
+        if (pFound < pK || lSqrDistance < pSqrDistances[pFound - 1])
+        {
+            // sorted insertion, k is expected to be small
+            size_t lPos = pFound < pK ? pFound++ : pK - 1;
+            while (lPos > 0 && pSqrDistances[lPos - 1] > lSqrDistance)
+            {
+                pSqrDistances[lPos] = pSqrDistances[lPos - 1];
+                pIndices[lPos] = pIndices[lPos - 1];
+                --lPos;
+            }
+            pSqrDistances[lPos] = lSqrDistance;
+            pIndices[lPos] = lIndex;
+        }
+        int lAxis = mAxes[lMid];
+        T lDiff = coord(pQuery, lAxis) - coord(mPoints[lIndex], lAxis);
+        size_t lNearBegin = lDiff < (T)0 ? pBegin : lMid + 1;
+        size_t lNearEnd = lDiff < (T)0 ? lMid : pEnd;
+        size_t lFarBegin = lDiff < (T)0 ? lMid + 1 : pBegin;
+        size_t lFarEnd = lDiff < (T)0 ? pEnd : lMid;
+        kNearestRange(pQuery, lNearBegin, lNearEnd, pK, pIndices, pSqrDistances, pFound);
+        if (pFound < pK || lDiff * lDiff < pSqrDistances[pFound - 1])
+        {
+            kNearestRange(pQuery, lFarBegin, lFarEnd, pK, pIndices, pSqrDistances, pFound);
+        }
+    }
+
+    template <class F>
+    void radiusRange(const Vector3<T>& pQuery, T pSqrRadius, size_t pBegin, size_t pEnd, F& pFunction) const
+    {
+        if (pBegin == pEnd)
+        {
+            return;
+        }
+        size_t lMid = pBegin + (pEnd - pBegin) / 2;
+        size_t lIndex = mIndices[lMid];
+        T lSqrDistance = (mPoints[lIndex] - pQuery).sqrLength();
+        if (lSqrDistance <= pSqrRadius)
+        {
+            pFunction(lIndex, lSqrDistance);
+        }
+        int lAxis = mAxes[lMid];
+        T lDiff = coord(pQuery, lAxis) - coord(mPoints[lIndex], lAxis);
+        if (lDiff <= (T)0 || lDiff * lDiff <= pSqrRadius)
+        {
+            radiusRange(pQuery, pSqrRadius, pBegin, lMid, pFunction);
+        }
+        if (lDiff >= (T)0 || lDiff * lDiff <= pSqrRadius)
+        {
+            radiusRange(pQuery, pSqrRadius, lMid + 1, pEnd, pFunction);
+        }
+    }
+
+    std::vector< Vector3<T> > mPoints;
+    std::vector<size_t>       mIndices;
+    std::vector<int>          mAxes;
+};
+
+//==============================================================================
+/**
+ @class CubeMapGrid
+ @brief Partition of the unit sphere into the cells of a cube map: 6 faces of
+ pResolution x pResolution cells. Mapping a direction to its cell is O(1) and
+ trigonometry-free.
+ */
+template <typename T>
+class CubeMapGrid
+{
+public:
+    explicit CubeMapGrid(int pResolution = 8)
+    : mResolution(std::max(1, pResolution))
+    , mCenters((size_t)(6 * mResolution * mResolution))
+    , mRadii((size_t)(6 * mResolution * mResolution))
+    {
+        for (int lFace = 0 ; lFace != 6 ; ++lFace)
+        {
+            for (int i = 0 ; i != mResolution ; ++i)
+            {
+                for (int j = 0 ; j != mResolution ; ++j)
+                {
+                    size_t lCell = cellIndex(lFace, i, j);
+                    mCenters[lCell] = faceToDirection(lFace, cellEdge(i) + (T)1 / (T)mResolution,
+                                                             cellEdge(j) + (T)1 / (T)mResolution);
+                    T lMinCos = (T)1;
+                    for (int lCorner = 0 ; lCorner != 4 ; ++lCorner)
+                    {
+                        Vector3<T> lCornerDir = faceToDirection(lFace, cellEdge(i + (lCorner & 1)),
+                                                                       cellEdge(j + (lCorner >> 1)));
+                        lMinCos = std::min(lMinCos, lCornerDir.dot(mCenters[lCell]));
+                    }
+                    mRadii[lCell] = std::acos(mu::limitedRange(lMinCos, (T)(-1), (T)1)) + (T)1e-4;
+                }
+            }
+        }
+    }
+
+    int getResolution() const
+    {
+        return mResolution;
+    }
+
+    size_t getNumCells() const
+    {
+        return mCenters.size();
+    }
+
+    /**
+     Cell of a direction. The direction does not need to be normalized but must
+     not be zero.
+     */
+    size_t cellOf(const Vector3<T>& pDirection) const
+    {
+        T ax = std::abs(pDirection.mX);
+        T ay = std::abs(pDirection.mY);
+        T az = std::abs(pDirection.mZ);
+        int lFace;
+        T u, v, lMajor;
+        if (ax >= ay && ax >= az)
+        {
+            lFace = pDirection.mX >= (T)0 ? 0 : 1;
+            lMajor = ax; u = pDirection.mY; v = pDirection.mZ;
+        }
+        else if (ay >= az)
+        {
+            lFace = pDirection.mY >= (T)0 ? 2 : 3;
+            lMajor = ay; u = pDirection.mX; v = pDirection.mZ;
+        }
+        else
+        {
+            lFace = pDirection.mZ >= (T)0 ? 4 : 5;
+            lMajor = az; u = pDirection.mX; v = pDirection.mY;
+        }
+        assert(lMajor > (T)0);
+        T lScale = (T)0.5 * (T)mResolution / lMajor;
+        int i = std::min(mResolution - 1, std::max(0, (int)((u * lScale) + (T)0.5 * (T)mResolution)));
+        int j = std::min(mResolution - 1, std::max(0, (int)((v * lScale) + (T)0.5 * (T)mResolution)));
+        return cellIndex(lFace, i, j);
+    }
+
+    /**
+     Normalized direction of the center of a cell.
+     */
+    const Vector3<T>& getCellCenter(size_t pCell) const
+    {
+        return mCenters[pCell];
+    }
+
+    /**
+     Angle (rad) from the cell center that encloses the whole cell.
+     */
+    T getCellAngularRadius(size_t pCell) const
+    {
+        return mRadii[pCell];
+    }
+
+private:
+    size_t cellIndex(int pFace, int i, int j) const
+    {
+        return (size_t)((pFace * mResolution + i) * mResolution + j);
+    }
+
+    T cellEdge(int i) const
+    {
+        return (T)(-1) + (T)2 * (T)i / (T)mResolution;
+    }
+
+    static Vector3<T> faceToDirection(int pFace, T u, T v)
+    {
+        T lSign = (pFace & 1) ? (T)(-1) : (T)1;
+        Vector3<T> lDir;
+        switch (pFace >> 1)
+        {
+            case 0: lDir = Vector3<T>::cartesian(lSign, u, v); break;
+            case 1: lDir = Vector3<T>::cartesian(u, lSign, v); break;
+            default: lDir = Vector3<T>::cartesian(u, v, lSign); break;
+        }
+        return lDir.normalized();
+    }
+
+    int mResolution;
+    std::vector< Vector3<T> > mCenters;
+    std::vector<T>            mRadii;
+};
+
+//==============================================================================
+/**
+ @class DirectionIndex
+ @brief Index over unit directions (e.g. HRTF measurement or speaker
+ positions) for nearest-direction queries.
+
+ The nearest query looks up the cube map cell of the direction and only scans
+ the candidates precomputed for that cell, which is exact: a direction in a
+ cell of angular radius r can only be nearest to points within (d + 2r) of the
+ cell center, d being the angle from the center to its own nearest point.
+ k-nearest and angular radius queries go through a KDTree of the unit vectors,
+ as the chord distance is monotonic with the angle.
+ */
+template <typename T>
+class DirectionIndex
+{
+public:
+    DirectionIndex()
+    {
+    }
+
+    /**
+     @param pResolution The cube map resolution per face, 0 for an automatic
+     choice giving a handful of candidates per cell.
+     */
+    DirectionIndex(const Vector3<T>* pDirections, size_t pNumDirections, int pResolution = 0)
+    {
+        build(pDirections, pNumDirections, pResolution);
+    }
+
+    DirectionIndex(const AE<T>* pDirections, size_t pNumDirections, int pResolution = 0)
+    {
+        std::vector< Vector3<T> > lDirections(pNumDirections);
+        for (size_t u = 0 ; u != pNumDirections ; ++u)
+        {
+            lDirections[u] = Vector3<T>::fromAE(pDirections[u]);
+        }
+        build(lDirections.data(), pNumDirections, pResolution);
+    }
+
+    void build(const Vector3<T>* pDirections, size_t pNumDirections, int pResolution = 0)
+    {
+        std::vector< Vector3<T> > lNormalized(pNumDirections);
+        for (size_t u = 0 ; u != pNumDirections ; ++u)
+        {
+            lNormalized[u] = pDirections[u].normalized();
+        }
+        mTree.build(lNormalized.data(), pNumDirections);
+        if (pResolution <= 0)
+        {
+            pResolution = std::max(1, (int)std::ceil(std::sqrt((double)pNumDirections / 6.)));
+        }
+        mGrid = CubeMapGrid<T>(pResolution);
+        mCellStarts.assign(mGrid.getNumCells() + 1, 0);
+        mCandidates.clear();
+        if (pNumDirections == 0)
+        {
+            return;
+        }
+        for (size_t lCell = 0 ; lCell != mGrid.getNumCells() ; ++lCell)
+        {
+            mCellStarts[lCell] = mCandidates.size();
+            const Vector3<T>& lCenter = mGrid.getCellCenter(lCell);
+            size_t lNearest = mTree.nearest(lCenter);
+            T lAngle = angle(lCenter, mTree.getPoint(lNearest)) + (T)2 * mGrid.getCellAngularRadius(lCell);
+            mTree.forEachInRadius(lCenter, chordForAngle(lAngle), [this](size_t pIndex, T) {
+                mCandidates.push_back(pIndex);
+            });
+        }
+        mCellStarts[mGrid.getNumCells()] = mCandidates.size();
+    }
+
+    size_t size() const
+    {
+        return mTree.size();
+    }
+
+    const Vector3<T>& getDirection(size_t pIndex) const
+    {
+        return mTree.getPoint(pIndex);
+    }
+
+    /**
+     Index of the nearest direction (largest dot product), or size() if empty.
+     */
+    size_t nearest(const Vector3<T>& pDirection) const
+    {
+        size_t lBest = size();
+        if (lBest == 0 || pDirection.isZero())
+        {
+            return lBest;
+        }
+        size_t lCell = mGrid.cellOf(pDirection);
+        T lBestDot = - std::numeric_limits<T>::max();
+        for (size_t u = mCellStarts[lCell] ; u != mCellStarts[lCell + 1] ; ++u)
+        {
+            T lDot = mTree.getPoint(mCandidates[u]).dot(pDirection);
+            if (lDot > lBestDot)
+            {
+                lBestDot = lDot;
+                lBest = mCandidates[u];
+            }
+        }
+        return lBest;
+    }
+
+    size_t nearest(const AE<T>& pDirection) const
+    {
+        return nearest(Vector3<T>::fromAE(pDirection));
+    }
+
+    void nearestBatch(const Vector3<T>* pDirections, size_t pNumDirections, size_t* pIndices) const
+    {
+        for (size_t u = 0 ; u != pNumDirections ; ++u)
+        {
+            pIndices[u] = nearest(pDirections[u]);
+        }
+    }
+
+    void nearestBatch(const AE<T>* pDirections, size_t pNumDirections, size_t* pIndices) const
+    {
+        for (size_t u = 0 ; u != pNumDirections ; ++u)
+        {
+            pIndices[u] = nearest(pDirections[u]);
+        }
+    }
+
+    /**
+     The pK nearest directions, sorted by increasing angle. Nothing is
+     allocated: pAngles (pK elements) first receives the squared chords from
+     the KDTree, converted to angles in place.
+     @return the number of directions found.
+     */
+    size_t kNearest(const Vector3<T>& pDirection, size_t pK, size_t* pIndices, T* pAngles) const
+    {
+        size_t lFound = mTree.kNearest(pDirection.normalized(), pK, pIndices, pAngles);
+        for (size_t u = 0 ; u != lFound ; ++u)
+        {
+            pAngles[u] = (T)2 * std::asin(mu::limitedRange((T)0.5 * std::sqrt(pAngles[u]), (T)0, (T)1));
+        }
+        return lFound;
+    }
+
+    /**
+     Indices of the directions within pAngle (rad) of pDirection.
+     */
+    void withinAngle(const Vector3<T>& pDirection, T pAngle, std::vector<size_t>& pIndices) const
+    {
+        mTree.radius(pDirection.normalized(), chordForAngle(pAngle), pIndices);
+    }
+
+private:
+    static T angle(const Vector3<T>& pA, const Vector3<T>& pB)
+    {
+        return std::acos(mu::limitedRange(pA.dot(pB), (T)(-1), (T)1));
+    }
+
+    static T chordForAngle(T pAngle)
+    {
+        return (T)2 * std::sin((T)0.5 * std::min(pAngle, (T)M_PI)) + (T)1e-5;
+    }
+
+    KDTree<T>           mTree;
+    CubeMapGrid<T>      mGrid;
+    std::vector<size_t> mCellStarts;
+    std::vector<size_t> mCandidates;
+};
+
+}
+
+#endif
@@ -0,0 +1,315 @@
+#ifndef FBU_SPECTRUM_ANALYZER_HPP_INCLUDED
+#define FBU_SPECTRUM_ANALYZER_HPP_INCLUDED
+
+/**
+ @file spectrum_analyzer.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/complex_vect.hpp"
+#include "fbu/fft.hpp"
+#include "fbu/spsc_fifo.hpp"
+#include "fbu/thread_pool.hpp"
+#include "fbu/triple_buffer.hpp"
+#include "fbu/window.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ @class SpectrumAnalyzer
+ @brief Spectrum display engine that keeps the FFTs off the audio thread.
+
+ - push(), audio thread: copies the samples into a wait-free SPSCFifo, and
+   nothing else. Samples are dropped when the FIFO is full.
+ - update(), one GUI thread: at most pMaxFrameRate times per second, and only
+   if the previous job is done, schedules a job on the ThreadPool (or runs it
+   inline without one), then fetches the latest frame.
+ - The job drains the FIFO, Hann-windows the last getFFTSize() samples and
+   runs a RealFFT. The power of each bin is averaged exponentially and kept
+   by a peak-hold that falls at a constant rate, both with the time elapsed in
+   samples. The bins are grouped in log-spaced bands (their maximum) and the
+   frame is published through a TripleBuffer.
+
+ The CPU cost is bounded by the frame rate, whatever the block size and the
+ sample rate. A full scale sine on a bin center reads 0 dB.
+ */
+class SpectrumAnalyzer
+: fbu::lang::NonCopyable
+{
+public:
+    struct Frame
+    {
+        uint64_t           mFrameIndex;
+        std::vector<float> mBandsDB;
+        std::vector<float> mPeaksDB;
+    };
+
+    /**
+     @param pFFTSize A power of 2.
+     @param pNumBands The number of log-spaced bands between pMinFrequency and
+     pMaxFrequency.
+     @param pThreadPool Where to run the analysis, or nullptr to run it inline
+     in update().
+     @param pMaxFrameRate In Hz, 0 for no limit.
+     */
+    SpectrumAnalyzer(size_t pFFTSize, double pSampleRate, int pNumBands, ThreadPool* pThreadPool = nullptr,
+                     double pMaxFrameRate = 30., double pMinFrequency = 20., double pMaxFrequency = 20000.)
+    : mFFT(RealFFT<float>::get(pFFTSize))
+    , mSampleRate(pSampleRate)
+    , mThreadPool(pThreadPool)
+    , mMinInterval(pMaxFrameRate > 0. ? 1. / pMaxFrameRate : 0.)
+    , mFifo(2 * std::max(pFFTSize, (size_t)(pSampleRate / 10.)))
+    , mAveragingTime(0.1f)
+    , mPeakFallRate(20.f)
+    , mInFlight(false)
+    , mLastSchedule(std::chrono::steady_clock::now() - std::chrono::hours(1))
+    , mInput(pFFTSize)
+    , mWindow(pFFTSize)
+    , mWindowed(pFFTSize)
+    , mSpectrum(mFFT->getNumBins())
+    , mPower(mFFT->getNumBins())
+    , mAverage(mFFT->getNumBins())
+    , mPeak(mFFT->getNumBins())
+    , mBandStarts((size_t)pNumBands)
+    , mBandEnds((size_t)pNumBands)
+    , mBandFrequencies((size_t)pNumBands)
+    , mFrameIndex(0)
+    , mFrames(Frame{0, std::vector<float>((size_t)pNumBands, -144.f), std::vector<float>((size_t)pNumBands, -144.f)})
+    {
+        fillWindow(WindowType::Hann, mWindow.data(), pFFTSize);
+        float lSum = 0.f;
+        for (float w : mWindow)
+        {
+            lSum += w;
+        }
+        // a sine of amplitude 1 peaks at sum(w)/2
+        mPowerScale = 4.f / (lSum * lSum);
+
+        const double lBinsPerHz = (double)pFFTSize / pSampleRate;
+        const double lRatio = pMaxFrequency / pMinFrequency;
+        for (int b = 0 ; b != pNumBands ; ++b)
+        {
+            double lLow = pMinFrequency * std::pow(lRatio, (double)b / pNumBands);
+            double lHigh = pMinFrequency * std::pow(lRatio, (double)(b + 1) / pNumBands);
+            size_t lStart = std::min((size_t)std::lround(lLow * lBinsPerHz), mSpectrum.size() - 1);
+            size_t lEnd = std::min((size_t)std::lround(lHigh * lBinsPerHz), mSpectrum.size());
+            mBandStarts[(size_t)b] = lStart;
+            mBandEnds[(size_t)b] = std::max(lEnd, lStart + 1);
+            mBandFrequencies[(size_t)b] = (float)std::sqrt(lLow * lHigh);
+        }
+        reset();
+    }
+
+    ~SpectrumAnalyzer()
+    {
+        mJobs.waitForCompletion();
+    }
+
+    size_t getFFTSize() const
+    {
+        return mFFT->getSize();
+    }
+
+    int getNumBands() const
+    {
+        return (int)mBandStarts.size();
+    }
+
+    /**
+     The geometric center of a band, in Hz, e.g. for the labels.
+     */
+    float getBandFrequency(int pBand) const
+    {
+        return mBandFrequencies[(size_t)pBand];
+    }
+
+    /**
+     @param pSeconds The time constant of the power average, 0 for none.
+     */
+    void setAveragingTime(float pSeconds)
+    {
+        mAveragingTime.store(pSeconds, std::memory_order_relaxed);
+    }
+
+    /**
+     @param pDBPerSecond The fall rate of the peak-hold.
+     */
+    void setPeakFallRate(float pDBPerSecond)
+    {
+        mPeakFallRate.store(pDBPerSecond, std::memory_order_relaxed);
+    }
+
+    /**
+     Audio thread: wait-free.
+     */
+    void push(const float* pIn, int pNumSamples)
+    {
+        mFifo.push(pIn, (size_t)pNumSamples);
+    }
+
+    /**
+     GUI thread: schedule the analysis if due, then fetch the latest frame.
+     @return whether the frame changed.
+     */
+    bool update()
+    {
+        std::chrono::steady_clock::time_point lNow = std::chrono::steady_clock::now();
+        if (!mInFlight.load(std::memory_order_acquire)
+            && std::chrono::duration<double>(lNow - mLastSchedule).count() >= mMinInterval
+            && mFifo.getNumReady() != 0)
+        {
+            mLastSchedule = lNow;
+            mInFlight.store(true, std::memory_order_relaxed);
+            if (mThreadPool != nullptr)
+            {
+                mJobs.increment();
+                mThreadPool->addJob([this]{
+                    analyze();
+                    mInFlight.store(false, std::memory_order_release);
+                    mJobs.decrement();
+                });
+            }
+            else
+            {
+                analyze();
+                mInFlight.store(false, std::memory_order_relaxed);
+            }
+        }
+        return mFrames.update();
+    }
+
+    /**
+     GUI thread: the frame fetched by the last update().
+     */
+    const Frame& getFrame() const
+    {
+        return mFrames.getReadBuffer();
+    }
+
+private:
+    /**
+     Only called before the first job.
+     */
+    void reset()
+    {
+        std::fill(mInput.begin(), mInput.end(), 0.f);
+        std::fill(mAverage.begin(), mAverage.end(), 0.f);
+        std::fill(mPeak.begin(), mPeak.end(), 0.f);
+    }
+
+    void analyze()
+    {
+        const size_t N = mInput.size();
+        // keep the last N samples
+        size_t lNumNewSamples = 0;
+        size_t lNumRead;
+        while ((lNumRead = mFifo.pop(mWindowed.data(), N)) != 0)
+        {
+            std::copy(mInput.begin() + (std::ptrdiff_t)lNumRead, mInput.end(), mInput.begin());
+            std::copy(mWindowed.begin(), mWindowed.begin() + (std::ptrdiff_t)lNumRead,
+                      mInput.end() - (std::ptrdiff_t)lNumRead);
+            lNumNewSamples += lNumRead;
+        }
+        if (lNumNewSamples == 0)
+        {
+            return;
+        }
+        for (size_t u = 0 ; u != N ; ++u)
+        {
+            mWindowed[u] = mInput[u] * mWindow[u];
+        }
+        mFFT->forward(mWindowed.data(), mSpectrum.data());
+        vectSqrMagnitude(mSpectrum.data(), mPower.data(), mSpectrum.size());
+
+        const double lElapsed = (double)lNumNewSamples / mSampleRate;
+        const float lAveragingTime = mAveragingTime.load(std::memory_order_relaxed);
+        const float a = lAveragingTime > 0.f ? (float)(1. - std::exp(-lElapsed / lAveragingTime)) : 1.f;
+        const float lFall = (float)std::pow(10., -mPeakFallRate.load(std::memory_order_relaxed) * lElapsed / 10.);
+        const float lScale = mPowerScale;
+        for (size_t k = 0 ; k != mPower.size() ; ++k)
+        {
+            mAverage[k] += a * (lScale * mPower[k] - mAverage[k]);
+            mPeak[k] = std::max(mAverage[k], mPeak[k] * lFall);
+        }
+
+        Frame& lFrame = mFrames.getWriteBuffer();
+        for (size_t b = 0 ; b != mBandStarts.size() ; ++b)
+        {
+            const float* lAverageStart = mAverage.data() + mBandStarts[b];
+            const float* lAverageEnd = mAverage.data() + mBandEnds[b];
+            const float* lPeakStart = mPeak.data() + mBandStarts[b];
+            const float* lPeakEnd = mPeak.data() + mBandEnds[b];
+            lFrame.mBandsDB[b] = powerToDB(*std::max_element(lAverageStart, lAverageEnd));
+            lFrame.mPeaksDB[b] = powerToDB(*std::max_element(lPeakStart, lPeakEnd));
+        }
+        lFrame.mFrameIndex = ++mFrameIndex;
+        mFrames.publish();
+    }
+
+    static float powerToDB(float pPower)
+    {
+        return pPower > 1e-15f ? std::max(10.f * std::log10(pPower), -144.f) : -144.f;
+    }
+
+    std::shared_ptr< const RealFFT<float> > mFFT;
+    double                                  mSampleRate;
+    ThreadPool*                             mThreadPool;
+    double                                  mMinInterval;
+    SPSCFifo<float>                         mFifo;
+    std::atomic<float>                      mAveragingTime;
+    std::atomic<float>                      mPeakFallRate;
+    // scheduling, GUI thread
+    std::atomic<bool>                       mInFlight;
+    std::chrono::steady_clock::time_point   mLastSchedule;
+    JobCounter                              mJobs;
+    // owned by the job
+    float                                   mPowerScale;
+    std::vector<float>                      mInput;
+    std::vector<float>                      mWindow;
+    std::vector<float>                      mWindowed;
+    std::vector< Complex<float> >           mSpectrum;
+    std::vector<float>                      mPower;
+    std::vector<float>                      mAverage;
+    std::vector<float>                      mPeak;
+    std::vector<size_t>                     mBandStarts;
+    std::vector<size_t>                     mBandEnds;
+    std::vector<float>                      mBandFrequencies;
+    uint64_t                                mFrameIndex;
+    TripleBuffer<Frame>                     mFrames;
+};
+
+}
+
+#endif
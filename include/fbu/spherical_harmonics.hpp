@@ -0,0 +1,285 @@
+#ifndef FBU_SPHERICAL_HARMONICS_HPP_INCLUDED
+#define FBU_SPHERICAL_HARMONICS_HPP_INCLUDED
+
+/**
+ @file spherical_harmonics.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/vector3.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace fbu
+{
+
+enum class SHNormalization
+{
+    SN3D,
+    N3D
+};
+
+//==============================================================================
+/**
+ @class SphericalHarmonics
+ @brief Real spherical harmonics evaluator for ambisonics, ACN channel
+ ordering, without the Condon-Shortley phase.
+
+ The order is a template parameter so that all the loops have compile-time
+ bounds and get unrolled. The evaluation is trigonometry-free: it works on the
+ cartesian direction, using (x + iy)^m for the azimuthal terms and the
+ associated Legendre recurrence divided by cos(elevation)^m for the zenithal
+ terms. All the coefficients are precomputed in the constructor.
+ */
+template <typename T, int ORDER>
+class SphericalHarmonics
+{
+    static_assert(ORDER >= 0 && ORDER <= 7, "Spherical harmonics are supported up to order 7");
+
+public:
+    static constexpr int kOrder = ORDER;
+    static constexpr int kNumChannels = (ORDER + 1) * (ORDER + 1);
+
+    static constexpr int acn(int pL, int pM)
+    {
+        return pL * pL + pL + pM;
+    }
+
+    explicit SphericalHarmonics(SHNormalization pNormalization = SHNormalization::SN3D)
+    : mNormalization(pNormalization)
+    {
+        for (int l = 0 ; l <= ORDER ; ++l)
+        {
+            for (int m = -l ; m <= l ; ++m)
+            {
+                int lAbsM = std::abs(m);
+                // (l - |m|)! / (l + |m|)!
+                double lFactorialRatio = 1.;
+                for (int k = l - lAbsM + 1 ; k <= l + lAbsM ; ++k)
+                {
+                    lFactorialRatio /= (double)k;
+                }
+                double lNorm = std::sqrt((m == 0 ? 1. : 2.) * lFactorialRatio);
+                if (pNormalization == SHNormalization::N3D)
+                {
+                    lNorm *= std::sqrt(2. * l + 1.);
+                }
+                mNorm[acn(l, m)] = (T)lNorm;
+            }
+        }
+        for (int m = 0 ; m <= ORDER ; ++m)
+        {
+            double lDoubleFactorial = 1.;
+            for (int k = 2 * m - 1 ; k > 1 ; k -= 2)
+            {
+                lDoubleFactorial *= (double)k;
+            }
+            mLegendreDiagonal[m] = (T)lDoubleFactorial;
+            for (int l = 0 ; l <= ORDER ; ++l)
+            {
+                mLegendreA[l][m] = l > m ? (T)(2 * l - 1) / (T)(l - m) : (T)0;
+                mLegendreB[l][m] = l > m ? (T)(l + m - 1) / (T)(l - m) : (T)0;
+            }
+        }
+    }
+
+    SHNormalization getNormalization() const
+    {
+        return mNormalization;
+    }
+
+    /**
+     Evaluate the kNumChannels harmonics for a normalized direction.
+     */
+    void evaluate(const Vector3<T>& pDirection, T* pOut) const
+    {
+        const T x = pDirection.mX;
+        const T y = pDirection.mY;
+        const T z = pDirection.mZ;
+
+        // cos(m.az).cos(el)^m and sin(m.az).cos(el)^m
+        T lCos[ORDER + 1];
+        T lSin[ORDER + 1];
+        lCos[0] = (T)1;
+        lSin[0] = (T)0;
+        for (int m = 1 ; m <= ORDER ; ++m)
+        {
+            lCos[m] = lCos[m - 1] * x - lSin[m - 1] * y;
+            lSin[m] = lSin[m - 1] * x + lCos[m - 1] * y;
+        }
+
+        for (int m = 0 ; m <= ORDER ; ++m)
+        {
+            // P_l^m(z) / cos(el)^m, for l = m..ORDER
+            T lPrevious = (T)0;
+            T lCurrent = mLegendreDiagonal[m];
+            for (int l = m ; l <= ORDER ; ++l)
+            {
+                if (l > m)
+                {
+                    T lNext = mLegendreA[l][m] * z * lCurrent - mLegendreB[l][m] * lPrevious;
+                    lPrevious = lCurrent;
+                    lCurrent = lNext;
+                }
+                if (m == 0)
+                {
+                    pOut[acn(l, 0)] = mNorm[acn(l, 0)] * lCurrent;
+                }
+                else
+                {
+                    pOut[acn(l, m)] = mNorm[acn(l, m)] * lCurrent * lCos[m];
+                    pOut[acn(l, -m)] = mNorm[acn(l, -m)] * lCurrent * lSin[m];
+                }
+            }
+        }
+    }
+
+    void evaluate(const AE<T>& pDirection, T* pOut) const
+    {
+        evaluate(Vector3<T>::fromAE(pDirection), pOut);
+    }
+
+    /**
+     The magnitude is ignored: only the direction is encoded.
+     */
+    void evaluate(const AEM<T>& pDirection, T* pOut) const
+    {
+        evaluate(AE<T>::fromAEM(pDirection), pOut);
+    }
+
+    /**
+     Evaluate many directions. pOut is direction-major: the harmonics of
+     direction u start at pOut + u * kNumChannels.
+     */
+    template <class D>
+    void evaluateBatch(const D* pDirections, size_t pNumDirections, T* pOut) const
+    {
+        for (size_t u = 0 ; u != pNumDirections ; ++u)
+        {
+            evaluate(pDirections[u], pOut + u * (size_t)kNumChannels);
+        }
+    }
+
+private:
+    SHNormalization mNormalization;
+    T mNorm[kNumChannels];
+    T mLegendreDiagonal[ORDER + 1];
+    T mLegendreA[ORDER + 1][ORDER + 1];
+    T mLegendreB[ORDER + 1][ORDER + 1];
+};
+
+template <typename T, int ORDER> constexpr int SphericalHarmonics<T, ORDER>::kOrder;
+template <typename T, int ORDER> constexpr int SphericalHarmonics<T, ORDER>::kNumChannels;
+
+//==============================================================================
+/**
+ @class AmbisonicEncoder
+ @brief Encodes mono sources into ambisonic channels.
+
+ The gains of all the sources are evaluated once per call, then the source
+ buffers are accumulated into the ambisonic buffers by tiles of samples so
+ that the output tile stays in cache while all the sources are added to it.
+ */
+template <typename T, int ORDER>
+class AmbisonicEncoder
+{
+public:
+    static constexpr int kNumChannels = SphericalHarmonics<T, ORDER>::kNumChannels;
+
+    /**
+     @param pMaxNumSources The number of sources to preallocate gains for. The
+     multi-source encode() allocates if it is called with more sources.
+     */
+    explicit AmbisonicEncoder(SHNormalization pNormalization = SHNormalization::SN3D, int pMaxNumSources = 0)
+    : mHarmonics(pNormalization)
+    , mGains((size_t)(pMaxNumSources * kNumChannels))
+    {
+    }
+
+    const SphericalHarmonics<T, ORDER>& getHarmonics() const
+    {
+        return mHarmonics;
+    }
+
+    /**
+     Accumulate a source with precomputed gains into the ambisonic channels.
+     */
+    static void encode(const T* pSource, const T* pGains, T* const* pAmbisonicChannels, int pNumSamples)
+    {
+        for (int c = 0 ; c != kNumChannels ; ++c)
+        {
+            addProduct(pGains[c], pSource, pAmbisonicChannels[c], pNumSamples);
+        }
+    }
+
+    /**
+     Accumulate many sources into the ambisonic channels (which are not
+     cleared). D is Vector3<T> (normalized), AE<T> or AEM<T>.
+     */
+    template <class D>
+    void encode(const T* const* pSources, const D* pDirections, int pNumSources,
+                T* const* pAmbisonicChannels, int pNumSamples)
+    {
+        static constexpr int kTileSize = 64;
+        if (mGains.size() < (size_t)(pNumSources * kNumChannels))
+        {
+            mGains.resize((size_t)(pNumSources * kNumChannels));
+        }
+        mHarmonics.evaluateBatch(pDirections, (size_t)pNumSources, mGains.data());
+        for (int lStart = 0 ; lStart < pNumSamples ; lStart += kTileSize)
+        {
+            int lNumSamples = std::min(kTileSize, pNumSamples - lStart);
+            for (int s = 0 ; s != pNumSources ; ++s)
+            {
+                const T* lGains = mGains.data() + s * kNumChannels;
+                for (int c = 0 ; c != kNumChannels ; ++c)
+                {
+                    addProduct(lGains[c], pSources[s] + lStart, pAmbisonicChannels[c] + lStart, lNumSamples);
+                }
+            }
+        }
+    }
+
+private:
+    static void addProduct(T pGain, const T* __restrict pIn, T* __restrict pInOut, int pNumSamples)
+    {
+        for (int i = 0 ; i != pNumSamples ; ++i)
+        {
+            pInOut[i] += pGain * pIn[i];
+        }
+    }
+
+    SphericalHarmonics<T, ORDER> mHarmonics;
+    std::vector<T>               mGains;
+};
+
+template <typename T, int ORDER> constexpr int AmbisonicEncoder<T, ORDER>::kNumChannels;
+
+}
+
+#endif
@@ -0,0 +1,299 @@
+#ifndef FBU_SPLIT_COMPLEX_HPP_INCLUDED
+#define FBU_SPLIT_COMPLEX_HPP_INCLUDED
+
+/**
+ @file split_complex.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/aligned_buffer.hpp"
+#include "fbu/complex.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+//==============================================================================
+// Split-complex kernels: the real and imaginary parts are in separate arrays,
+// so every loop below is a plain element-wise loop that the compiler
+// vectorizes at full width, without the shuffles needed on interleaved data.
+// All the pointers are __restrict: the outputs must not alias the inputs, the
+// _I variants work in place.
+
+template<typename T>
+void vectDeinterleave(const Complex<T>* __restrict pIn, T* __restrict pRe, T* __restrict pIm, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pRe[u] = pIn[u].re;
+        pIm[u] = pIn[u].im;
+    }
+}
+
+template<typename T>
+void vectInterleave(const T* __restrict pRe, const T* __restrict pIm, Complex<T>* __restrict pOut, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pOut[u].re = pRe[u];
+        pOut[u].im = pIm[u];
+    }
+}
+
+/**
+ out = a * b. pOut must not alias a or b: use vectSplitMultiply_I in place.
+ */
+template<typename T>
+void vectSplitMultiply(const T* __restrict pARe, const T* __restrict pAIm,
+                       const T* __restrict pBRe, const T* __restrict pBIm,
+                       T* __restrict pOutRe, T* __restrict pOutIm, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        T lRe = pARe[u] * pBRe[u] - pAIm[u] * pBIm[u];
+        T lIm = pAIm[u] * pBRe[u] + pARe[u] * pBIm[u];
+        pOutRe[u] = lRe;
+        pOutIm[u] = lIm;
+    }
+}
+
+/**
+ acc += a * b. pAcc must not alias a or b.
+ */
+template<typename T>
+void vectSplitMultiplyAccumulate(const T* __restrict pARe, const T* __restrict pAIm,
+                                 const T* __restrict pBRe, const T* __restrict pBIm,
+                                 T* __restrict pAccRe, T* __restrict pAccIm, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pAccRe[u] += pARe[u] * pBRe[u] - pAIm[u] * pBIm[u];
+        pAccIm[u] += pAIm[u] * pBRe[u] + pARe[u] * pBIm[u];
+    }
+}
+
+/**
+ out = a * conj(b). pOut must not alias a or b: use vectSplitConjMultiply_I in
+ place.
+ */
+template<typename T>
+void vectSplitConjMultiply(const T* __restrict pARe, const T* __restrict pAIm,
+                           const T* __restrict pBRe, const T* __restrict pBIm,
+                           T* __restrict pOutRe, T* __restrict pOutIm, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        T lRe = pARe[u] * pBRe[u] + pAIm[u] * pBIm[u];
+        T lIm = pAIm[u] * pBRe[u] - pARe[u] * pBIm[u];
+        pOutRe[u] = lRe;
+        pOutIm[u] = lIm;
+    }
+}
+
+/**
+ acc += a * conj(b). pAcc must not alias a or b.
+ */
+template<typename T>
+void vectSplitConjMultiplyAccumulate(const T* __restrict pARe, const T* __restrict pAIm,
+                                     const T* __restrict pBRe, const T* __restrict pBIm,
+                                     T* __restrict pAccRe, T* __restrict pAccIm, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pAccRe[u] += pARe[u] * pBRe[u] + pAIm[u] * pBIm[u];
+        pAccIm[u] += pAIm[u] * pBRe[u] - pARe[u] * pBIm[u];
+    }
+}
+
+template<typename T>
+void vectSplitSqrMagnitude(const T* __restrict pRe, const T* __restrict pIm, T* __restrict pOut, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pOut[u] = pRe[u] * pRe[u] + pIm[u] * pIm[u];
+    }
+}
+
+/**
+ sqrt(re^2 + im^2): unlike Complex<T>::mag() there is no overflow protection,
+ which is what lets the loop vectorize.
+ */
+template<typename T>
+void vectSplitMagnitude(const T* __restrict pRe, const T* __restrict pIm, T* __restrict pOut, size_t pSize)
+{
+    vectSplitSqrMagnitude(pRe, pIm, pOut, pSize);
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pOut[u] = std::sqrt(pOut[u]);
+    }
+}
+
+template<typename T>
+void vectSplitSubtract_I(const T* __restrict pInRe, const T* __restrict pInIm,
+                         T* __restrict pInOutRe, T* __restrict pInOutIm, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pInOutRe[u] -= pInRe[u];
+        pInOutIm[u] -= pInIm[u];
+    }
+}
+
+/**
+ inOut *= b
+ */
+template<typename T>
+void vectSplitMultiply_I(const T* __restrict pInRe, const T* __restrict pInIm,
+                         T* __restrict pInOutRe, T* __restrict pInOutIm, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        T lRe = pInOutRe[u] * pInRe[u] - pInOutIm[u] * pInIm[u];
+        T lIm = pInOutIm[u] * pInRe[u] + pInOutRe[u] * pInIm[u];
+        pInOutRe[u] = lRe;
+        pInOutIm[u] = lIm;
+    }
+}
+
+/**
+ inOut *= conj(b)
+ */
+template<typename T>
+void vectSplitConjMultiply_I(const T* __restrict pInRe, const T* __restrict pInIm,
+                             T* __restrict pInOutRe, T* __restrict pInOutIm, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        T lRe = pInOutRe[u] * pInRe[u] + pInOutIm[u] * pInIm[u];
+        T lIm = pInOutIm[u] * pInRe[u] - pInOutRe[u] * pInIm[u];
+        pInOutRe[u] = lRe;
+        pInOutIm[u] = lIm;
+    }
+}
+
+template<typename T>
+void vectSplitProductSC_I(T pS, T* __restrict pInOutRe, T* __restrict pInOutIm, size_t pSize)
+{
+    for (size_t u = 0 ; u != pSize ; ++u)
+    {
+        pInOutRe[u] *= pS;
+        pInOutIm[u] *= pS;
+    }
+}
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ @class SplitComplexBuffer
+ @brief Array of complex numbers stored as separate, aligned real and
+ imaginary arrays, to be processed with the vectSplit* kernels.
+ */
+template <typename T>
+class SplitComplexBuffer
+{
+public:
+    explicit SplitComplexBuffer(size_t pSize = 0)
+    : mRe(pSize)
+    , mIm(pSize)
+    {
+    }
+
+    /**
+     Reallocate: the previous content is lost and the elements are zeroed.
+     */
+    void resize(size_t pSize)
+    {
+        mRe.resize(pSize);
+        mIm.resize(pSize);
+    }
+
+    void clear()
+    {
+        mRe.clear();
+        mIm.clear();
+    }
+
+    size_t size() const
+    {
+        return mRe.size();
+    }
+
+    T* re()
+    {
+        return mRe.data();
+    }
+
+    const T* re() const
+    {
+        return mRe.data();
+    }
+
+    T* im()
+    {
+        return mIm.data();
+    }
+
+    const T* im() const
+    {
+        return mIm.data();
+    }
+
+    Complex<T> get(size_t pIndex) const
+    {
+        return Complex<T>({mRe[pIndex], mIm[pIndex]});
+    }
+
+    void set(size_t pIndex, const Complex<T>& pValue)
+    {
+        mRe[pIndex] = pValue.re;
+        mIm[pIndex] = pValue.im;
+    }
+
+    /**
+     Copy size() interleaved values in.
+     */
+    void fromInterleaved(const Complex<T>* pIn)
+    {
+        vectDeinterleave(pIn, re(), im(), size());
+    }
+
+    /**
+     Copy the size() values out, interleaved.
+     */
+    void toInterleaved(Complex<T>* pOut) const
+    {
+        vectInterleave(re(), im(), pOut, size());
+    }
+
+private:
+    AlignedBuffer<T> mRe;
+    AlignedBuffer<T> mIm;
+};
+
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef FBU_SPSC_FIFO_HPP_INCLUDED
+#define FBU_SPSC_FIFO_HPP_INCLUDED
+
+/**
+ @file spsc_fifo.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <fbu/lang_utils.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ @class SPSCFifo
+ @brief Wait-free single producer, single consumer FIFO of trivially copyable
+ values, such as audio samples sent from the audio thread to a worker.
+
+ The capacity is rounded up to a power of 2. The read and write positions are
+ free-running counters: each side only stores its own, with release
+ semantics, after copying the values. No allocation after construction.
+ */
+template <typename T>
+class SPSCFifo
+: fbu::lang::NonCopyable
+{
+public:
+    explicit SPSCFifo(size_t pCapacity)
+    : mBuffer(roundUpToPowerOf2(pCapacity))
+    , mMask(mBuffer.size() - 1)
+    , mReadPosition(0)
+    , mWritePosition(0)
+    {
+    }
+
+    size_t getCapacity() const
+    {
+        return mBuffer.size();
+    }
+
+    /**
+     Producer: write up to pSize values.
+     @return the number of values written, less than pSize when full.
+     */
+    size_t push(const T* pIn, size_t pSize)
+    {
+        const size_t lWrite = mWritePosition.load(std::memory_order_relaxed);
+        const size_t lRead = mReadPosition.load(std::memory_order_acquire);
+        const size_t lSize = std::min(pSize, getCapacity() - (lWrite - lRead));
+        writeToRing(pIn, lWrite, lSize);
+        mWritePosition.store(lWrite + lSize, std::memory_order_release);
+        return lSize;
+    }
+
+    /**
+     Consumer: read up to pSize values.
+     @return the number of values read, less than pSize when empty.
+     */
+    size_t pop(T* pOut, size_t pSize)
+    {
+        const size_t lRead = mReadPosition.load(std::memory_order_relaxed);
+        const size_t lWrite = mWritePosition.load(std::memory_order_acquire);
+        const size_t lSize = std::min(pSize, lWrite - lRead);
+        readFromRing(pOut, lRead, lSize);
+        mReadPosition.store(lRead + lSize, std::memory_order_release);
+        return lSize;
+    }
+
+    /**
+     Consumer: the number of values that can be read.
+     */
+    size_t getNumReady() const
+    {
+        return mWritePosition.load(std::memory_order_acquire) - mReadPosition.load(std::memory_order_relaxed);
+    }
+
+private:
+    static size_t roundUpToPowerOf2(size_t pSize)
+    {
+        size_t lSize = 1;
+        while (lSize < pSize)
+        {
+            lSize *= 2;
+        }
+        return lSize;
+    }
+
+    /**
+     The ring copies are in two parts when they wrap around.
+     */
+    void writeToRing(const T* pValues, size_t pPosition, size_t pSize)
+    {
+        const size_t lStart = pPosition & mMask;
+        const size_t lFirst = std::min(pSize, getCapacity() - lStart);
+        std::copy(pValues, pValues + lFirst, mBuffer.begin() + (std::ptrdiff_t)lStart);
+        std::copy(pValues + lFirst, pValues + pSize, mBuffer.begin());
+    }
+
+    void readFromRing(T* pValues, size_t pPosition, size_t pSize)
+    {
+        const size_t lStart = pPosition & mMask;
+        const size_t lFirst = std::min(pSize, getCapacity() - lStart);
+        std::copy(mBuffer.begin() + (std::ptrdiff_t)lStart, mBuffer.begin() + (std::ptrdiff_t)(lStart + lFirst), pValues);
+        std::copy(mBuffer.begin(), mBuffer.begin() + (std::ptrdiff_t)(pSize - lFirst), pValues + lFirst);
+    }
+
+    std::vector<T>      mBuffer;
+    size_t              mMask;
+    // written by the consumer and the producer, kept on separate cache lines:
+    // they are 64 bytes apart even where new does not honour the alignment
+    // (before C++17)
+    alignas(64) std::atomic<size_t> mReadPosition;
+    alignas(64) std::atomic<size_t> mWritePosition;
+};
+
+}
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef FBU_STFT_HPP_INCLUDED
+#define FBU_STFT_HPP_INCLUDED
+
+/**
+ @file stft.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/fft.hpp"
+#include "fbu/window.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ @class STFT
+ @brief Streaming short-time Fourier transform analysis, per-frame spectral
+ processing and overlap-add resynthesis.
+
+ Every getHopSize() input samples, the last getFFTSize() samples are windowed
+ by the analysis window and transformed with RealFFT; the callback modifies the
+ getNumBins() bins in place; the inverse transform is windowed by the synthesis
+ window and overlap-added to the output.
+
+ The synthesis window is normalized so that the sum of the analysis-synthesis
+ window products over the overlapping frames is 1 at every sample: with an
+ identity callback, the output is the input delayed by getLatency(), for any
+ window pair and hop (as long as the windows overlap everywhere).
+
+ process() accepts any number of samples; nothing is allocated after
+ construction.
+ */
+template <typename T>
+class STFT
+{
+public:
+    /**
+     @param pFFTSize The frame size, a power of 2.
+     @param pHopSize The number of samples between frames, at most pFFTSize.
+     */
+    STFT(size_t pFFTSize, size_t pHopSize,
+         WindowType pAnalysisWindow = WindowType::Hann, WindowType pSynthesisWindow = WindowType::Hann)
+    : mFFT(RealFFT<T>::get(pFFTSize))
+    , mHopSize(pHopSize)
+    , mAnalysisWindow(pFFTSize)
+    , mSynthesisWindow(pFFTSize)
+    , mInput(pFFTSize)
+    , mFrame(pFFTSize)
+    , mBins(mFFT->getNumBins())
+    , mOverlapAdd(pFFTSize)
+    , mReady(pHopSize)
+    {
+        assert(pHopSize >= 1 && pHopSize <= pFFTSize);
+        fillWindow(pAnalysisWindow, mAnalysisWindow.data(), pFFTSize);
+        fillWindow(pSynthesisWindow, mSynthesisWindow.data(), pFFTSize);
+        // overlap-add of the window products, folded on the hop
+        std::vector<double> lSums(pHopSize, 0.);
+        for (size_t i = 0 ; i != pFFTSize ; ++i)
+        {
+            lSums[i % pHopSize] += (double)mAnalysisWindow[i] * (double)mSynthesisWindow[i];
+        }
+        for (size_t i = 0 ; i != pFFTSize ; ++i)
+        {
+            double lSum = lSums[i % pHopSize];
+            mSynthesisWindow[i] = lSum > 1e-9 ? (T)((double)mSynthesisWindow[i] / lSum) : (T)0;
+        }
+        reset();
+    }
+
+    size_t getFFTSize() const
+    {
+        return mFFT->getSize();
+    }
+
+    size_t getHopSize() const
+    {
+        return mHopSize;
+    }
+
+    size_t getNumBins() const
+    {
+        return mFFT->getNumBins();
+    }
+
+    /**
+     The delay between the input and the output, in samples.
+     */
+    size_t getLatency() const
+    {
+        return getFFTSize() - 1;
+    }
+
+    void reset()
+    {
+        std::fill(mInput.begin(), mInput.end(), (T)0);
+        std::fill(mOverlapAdd.begin(), mOverlapAdd.end(), (T)0);
+        std::fill(mReady.begin(), mReady.end(), (T)0);
+        mPosition = 0;
+    }
+
+    /**
+     Process any number of samples. pIn and pOut may be the same buffer.
+     @param pCallback Called for each frame as pCallback(Complex<T>* pBins,
+     size_t pNumBins), to modify the spectrum in place.
+     */
+    template <class F>
+    void process(const T* pIn, T* pOut, size_t pNumSamples, F&& pCallback)
+    {
+        const size_t lFFTSize = getFFTSize();
+        while (pNumSamples != 0)
+        {
+            size_t n = std::min(pNumSamples, mHopSize - mPosition);
+            std::copy(pIn, pIn + n, mInput.begin() + (std::ptrdiff_t)(lFFTSize - mHopSize + mPosition));
+            // the sample completing a hop is output from the frame it completes
+            bool lCompletesHop = mPosition + n == mHopSize;
+            size_t lNumReady = lCompletesHop ? n - 1 : n;
+            std::copy(mReady.begin() + (std::ptrdiff_t)(mPosition + 1),
+                      mReady.begin() + (std::ptrdiff_t)(mPosition + 1 + lNumReady), pOut);
+            mPosition += n;
+            if (lCompletesHop)
+            {
+                processFrame(pCallback);
+                mPosition = 0;
+                pOut[n - 1] = mReady[0];
+            }
+            pIn += n;
+            pOut += n;
+            pNumSamples -= n;
+        }
+    }
+
+private:
+    template <class F>
+    void processFrame(F& pCallback)
+    {
+        const size_t lFFTSize = getFFTSize();
+        for (size_t i = 0 ; i != lFFTSize ; ++i)
+        {
+            mFrame[i] = mInput[i] * mAnalysisWindow[i];
+        }
+        mFFT->forward(mFrame.data(), mBins.data());
+        pCallback(mBins.data(), mBins.size());
+        mFFT->inverse(mBins.data(), mFrame.data());
+        for (size_t i = 0 ; i != lFFTSize ; ++i)
+        {
+            mOverlapAdd[i] += mFrame[i] * mSynthesisWindow[i];
+        }
+        // the first hop is complete: no later frame overlaps it
+        std::copy(mOverlapAdd.begin(), mOverlapAdd.begin() + (std::ptrdiff_t)mHopSize, mReady.begin());
+        std::copy(mOverlapAdd.begin() + (std::ptrdiff_t)mHopSize, mOverlapAdd.end(), mOverlapAdd.begin());
+        std::fill(mOverlapAdd.end() - (std::ptrdiff_t)mHopSize, mOverlapAdd.end(), (T)0);
+        std::copy(mInput.begin() + (std::ptrdiff_t)mHopSize, mInput.end(), mInput.begin());
+    }
+
+    std::shared_ptr< const RealFFT<T> > mFFT;
+    size_t                              mHopSize;
+    std::vector<T>                      mAnalysisWindow;
+    std::vector<T>                      mSynthesisWindow;
+    std::vector<T>                      mInput;
+    std::vector<T>                      mFrame;
+    std::vector< Complex<T> >           mBins;
+    std::vector<T>                      mOverlapAdd;
+    std::vector<T>                      mReady;
+    size_t                              mPosition;
+};
+
+typedef STFT<float> STFTf;
+
+}
+
+#endif
@@ -33,7 +33,10 @@ SOFTWARE.
 #include <queue>
 #include <atomic>
 #include <condition_variable>
+#include <mutex>
+#include <functional>
 #include <string>
+#include <cassert>
 #include <type_traits>
 #if __APPLE__
 #include <pthread.h>
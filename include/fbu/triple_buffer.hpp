@@ -0,0 +1,115 @@
+#ifndef FBU_TRIPLE_BUFFER_HPP_INCLUDED
+#define FBU_TRIPLE_BUFFER_HPP_INCLUDED
+
+/**
+ @file triple_buffer.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <fbu/lang_utils.hpp>
+
+#include <atomic>
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ @class TripleBuffer
+ @brief Wait-free single producer, single consumer exchange of the latest
+ value, typically the frames published by an audio thread for a GUI.
+
+ The writer fills getWriteBuffer() then publish()es it; the reader calls
+ update() then reads getReadBuffer(). Each side owns one of the three buffers
+ and they swap the third one with a single atomic exchange, so neither side
+ ever waits, copies or allocates: intermediate values are simply overwritten.
+ Containers in T should be sized by the initial value.
+ */
+template <typename T>
+class TripleBuffer
+: fbu::lang::NonCopyable
+{
+public:
+    explicit TripleBuffer(const T& pInitialValue = T())
+    : mBuffers{pInitialValue, pInitialValue, pInitialValue}
+    , mMiddle(1)
+    , mWriteIndex(0)
+    , mReadIndex(2)
+    {
+    }
+
+    /**
+     Writer: the buffer to fill before publish(). It holds the value written
+     two publications ago, or the initial value.
+     */
+    T& getWriteBuffer()
+    {
+        return mBuffers[mWriteIndex];
+    }
+
+    /**
+     Writer: make the write buffer the latest value.
+     */
+    void publish()
+    {
+        mWriteIndex = mMiddle.exchange(mWriteIndex | kDirty, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    /**
+     Reader: fetch the latest published value, if any.
+     @return whether the read buffer changed.
+     */
+    bool update()
+    {
+        if ((mMiddle.load(std::memory_order_relaxed) & kDirty) == 0)
+        {
+            return false;
+        }
+        mReadIndex = mMiddle.exchange(mReadIndex, std::memory_order_acq_rel) & kIndexMask;
+        return true;
+    }
+
+    /**
+     Reader: the value fetched by the last update().
+     */
+    const T& getReadBuffer() const
+    {
+        return mBuffers[mReadIndex];
+    }
+
+private:
+    static constexpr unsigned kDirty = 4;
+    static constexpr unsigned kIndexMask = 3;
+
+    T                     mBuffers[3];
+    std::atomic<unsigned> mMiddle;
+    // owned by the writer and the reader respectively
+    unsigned              mWriteIndex;
+    unsigned              mReadIndex;
+};
+
+}
+
+#endif
@@ -0,0 +1,268 @@
+#ifndef FBU_TRUE_PEAK_HPP_INCLUDED
+#define FBU_TRUE_PEAK_HPP_INCLUDED
+
+/**
+ @file true_peak.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Same compile-time selection as complex_vect.hpp.
+#if !defined(FBU_TRUE_PEAK_USE_SSE)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FBU_TRUE_PEAK_USE_SSE 1
+#else
+#define FBU_TRUE_PEAK_USE_SSE 0
+#endif
+#endif
+
+#if FBU_TRUE_PEAK_USE_SSE
+#include <emmintrin.h>
+#endif
+
+namespace fbu
+{
+
+enum class TruePeakOversampling
+{
+    X2,
+    X4
+};
+
+//==============================================================================
+/**
+ @class TruePeakDetector
+ @brief Per-block true-peak of N channels, ITU-R BS.1770-4 Annex 2.
+
+ X4 is the 48-tap, 4-phase polyphase FIR of the recommendation. The taps are
+ stored tap-major with the 4 phases as SIMD lanes, so each input sample costs
+ 12 broadcast multiply-adds and yields its 4 oversampled values in a single
+ register.
+
+ X2 is a cheaper approximation: the samples themselves plus an 8-tap windowed
+ sinc at the half-sample position, 4 consecutive outputs per register. It
+ misses the peaks at the quarter-sample positions: on content up to 0.4 fs it
+ under-reads by up to about 1.6 dB, instead of 0.4 dB for X4.
+
+ The last samples of each channel are kept, so blocks can have any size.
+ Nothing is allocated after construction.
+ */
+class TruePeakDetector
+{
+public:
+    explicit TruePeakDetector(int pNumChannels, TruePeakOversampling pOversampling = TruePeakOversampling::X4)
+    : mNumChannels(pNumChannels)
+    , mOversampling(pOversampling)
+    , mHistory((size_t)(pNumChannels * kHistorySize))
+    , mScratch((size_t)(kHistorySize + kChunkSize))
+    {
+        static const float kPhase0[kNumTaps] =
+        {
+            0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f,
+            -0.0594482421875f, 0.1373291015625f, 0.9721679687500f, -0.1022949218750f,
+            0.0476074218750f, -0.0266113281250f, 0.0148925781250f, -0.0083007812500f
+        };
+        static const float kPhase1[kNumTaps] =
+        {
+            -0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f,
+            -0.1665039062500f, 0.4650878906250f, 0.7797851562500f, -0.2003173828125f,
+            0.1015625000000f, -0.0582275390625f, 0.0330810546875f, -0.0189208984375f
+        };
+        // phases 2 and 3 are phases 1 and 0 reversed
+        for (int k = 0 ; k != kNumTaps ; ++k)
+        {
+            mTaps[k][0] = kPhase0[k];
+            mTaps[k][1] = kPhase1[k];
+            mTaps[k][2] = kPhase1[kNumTaps - 1 - k];
+            mTaps[k][3] = kPhase0[kNumTaps - 1 - k];
+        }
+        // Hann windowed sinc, delay 3.5 samples, normalized for unity DC gain
+        float lSum = 0.f;
+        for (int k = 0 ; k != kNumHalfSampleTaps ; ++k)
+        {
+            double t = (double)k - 3.5;
+            double lWindow = 0.5 + 0.5 * std::cos(M_PI * t / 5.);
+            mHalfSampleTaps[k] = (float)(lWindow * std::sin(M_PI * t) / (M_PI * t));
+            lSum += mHalfSampleTaps[k];
+        }
+        for (int k = 0 ; k != kNumHalfSampleTaps ; ++k)
+        {
+            mHalfSampleTaps[k] /= lSum;
+        }
+        reset();
+    }
+
+    int getNumChannels() const
+    {
+        return mNumChannels;
+    }
+
+    TruePeakOversampling getOversampling() const
+    {
+        return mOversampling;
+    }
+
+    void reset()
+    {
+        std::fill(mHistory.begin(), mHistory.end(), 0.f);
+    }
+
+    /**
+     @return the true-peak amplitude (linear) of this block of one channel.
+     */
+    float processChannel(int pChannel, const float* pIn, int pNumSamples)
+    {
+        float* lHistory = mHistory.data() + pChannel * kHistorySize;
+        float* lScratch = mScratch.data();
+        float lPeak = 0.f;
+        for (int lOffset = 0 ; lOffset < pNumSamples ; lOffset += kChunkSize)
+        {
+            int n = std::min((int)kChunkSize, pNumSamples - lOffset);
+            // the samples of the chunk follow their predecessors
+            std::copy(lHistory, lHistory + kHistorySize, lScratch);
+            std::copy(pIn + lOffset, pIn + lOffset + n, lScratch + kHistorySize);
+            const float* x = lScratch + kHistorySize;
+            float lChunkPeak = mOversampling == TruePeakOversampling::X4 ? peakX4(x, n) : peakX2(x, n);
+            lPeak = std::max(lPeak, lChunkPeak);
+            std::copy(lScratch + n, lScratch + n + kHistorySize, lHistory);
+        }
+        return lPeak;
+    }
+
+    /**
+     Write the true-peak amplitude (linear) of this block of each channel to
+     pPeaks.
+     */
+    void process(const float* const* pChannels, int pNumSamples, float* pPeaks)
+    {
+        for (int c = 0 ; c != mNumChannels ; ++c)
+        {
+            pPeaks[c] = processChannel(c, pChannels[c], pNumSamples);
+        }
+    }
+
+private:
+    static constexpr int kNumTaps = 12;
+    static constexpr int kNumHalfSampleTaps = 8;
+    static constexpr int kHistorySize = kNumTaps - 1;
+    static constexpr int kChunkSize = 256;
+
+    /**
+     x[-kHistorySize] to x[pSize - 1] are valid.
+     */
+    float peakX4(const float* x, int pSize) const
+    {
+#if FBU_TRUE_PEAK_USE_SSE
+        const __m128 lAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        __m128 lTaps[kNumTaps];
+        for (int k = 0 ; k != kNumTaps ; ++k)
+        {
+            lTaps[k] = _mm_loadu_ps(mTaps[k]);
+        }
+        __m128 lPeak = _mm_setzero_ps();
+        // split the sums in two halves to shorten the dependency chains
+        for (int i = 0 ; i != pSize ; ++i)
+        {
+            __m128 lLow = _mm_mul_ps(_mm_set1_ps(x[i]), lTaps[0]);
+            __m128 lHigh = _mm_mul_ps(_mm_set1_ps(x[i - kNumTaps / 2]), lTaps[kNumTaps / 2]);
+            for (int k = 1 ; k != kNumTaps / 2 ; ++k)
+            {
+                lLow = _mm_add_ps(lLow, _mm_mul_ps(_mm_set1_ps(x[i - k]), lTaps[k]));
+                lHigh = _mm_add_ps(lHigh, _mm_mul_ps(_mm_set1_ps(x[i - kNumTaps / 2 - k]), lTaps[kNumTaps / 2 + k]));
+            }
+            lPeak = _mm_max_ps(lPeak, _mm_and_ps(_mm_add_ps(lLow, lHigh), lAbsMask));
+        }
+        float lPeaks[4];
+        _mm_storeu_ps(lPeaks, lPeak);
+        return std::max(std::max(lPeaks[0], lPeaks[1]), std::max(lPeaks[2], lPeaks[3]));
+#else
+        float lPeak = 0.f;
+        for (int i = 0 ; i != pSize ; ++i)
+        {
+            float y[4] = {0.f, 0.f, 0.f, 0.f};
+            for (int k = 0 ; k != kNumTaps ; ++k)
+            {
+                for (int p = 0 ; p != 4 ; ++p)
+                {
+                    y[p] += x[i - k] * mTaps[k][p];
+                }
+            }
+            for (int p = 0 ; p != 4 ; ++p)
+            {
+                lPeak = std::max(lPeak, std::abs(y[p]));
+            }
+        }
+        return lPeak;
+#endif
+    }
+
+    float peakX2(const float* x, int pSize) const
+    {
+        int i = 0;
+        float lPeak = 0.f;
+#if FBU_TRUE_PEAK_USE_SSE
+        const __m128 lAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        __m128 lPeak4 = _mm_setzero_ps();
+        for ( ; i + 4 <= pSize ; i += 4)
+        {
+            __m128 y = _mm_mul_ps(_mm_loadu_ps(x + i), _mm_set1_ps(mHalfSampleTaps[0]));
+            for (int k = 1 ; k != kNumHalfSampleTaps ; ++k)
+            {
+                y = _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(x + i - k), _mm_set1_ps(mHalfSampleTaps[k])));
+            }
+            lPeak4 = _mm_max_ps(lPeak4, _mm_and_ps(y, lAbsMask));
+            lPeak4 = _mm_max_ps(lPeak4, _mm_and_ps(_mm_loadu_ps(x + i), lAbsMask));
+        }
+        float lPeaks[4];
+        _mm_storeu_ps(lPeaks, lPeak4);
+        lPeak = std::max(std::max(lPeaks[0], lPeaks[1]), std::max(lPeaks[2], lPeaks[3]));
+#endif
+        for ( ; i != pSize ; ++i)
+        {
+            float y = 0.f;
+            for (int k = 0 ; k != kNumHalfSampleTaps ; ++k)
+            {
+                y += x[i - k] * mHalfSampleTaps[k];
+            }
+            lPeak = std::max(lPeak, std::max(std::abs(y), std::abs(x[i])));
+        }
+        return lPeak;
+    }
+
+    int                  mNumChannels;
+    TruePeakOversampling mOversampling;
+    float                mTaps[kNumTaps][4];
+    float                mHalfSampleTaps[kNumHalfSampleTaps];
+    std::vector<float>   mHistory;
+    std::vector<float>   mScratch;
+};
+
+}
+
+#endif
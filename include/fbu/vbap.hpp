@@ -0,0 +1,628 @@
+#ifndef FBU_VBAP_HPP_INCLUDED
+#define FBU_VBAP_HPP_INCLUDED
+
+/**
+ @file vbap.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "fbu/matrix3.hpp"
+#include "fbu/spatial_index.hpp"
+#include "fbu/vector3.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace fbu
+{
+
+//==============================================================================
+/**
+ @class VBAP
+ @brief Vector-base amplitude panning over a fixed speaker layout.
+
+ The layout is triangulated once in the constructor (convex hull of the
+ speaker directions) and the inverse matrix of each triangle is precomputed.
+ When the speakers do not surround the listener (e.g. no speaker below the
+ horizontal plane), imaginary speakers are added to close the hull; their
+ gains are discarded. Layouts with all the speakers in the horizontal plane
+ use pairwise 2D panning, and layouts that cannot be triangulated (fewer than
+ 3 speakers) fall back to the nearest speaker.
+
+ The active triangle of a direction is found through a cube map of the sphere
+ where each cell lists the triangles that may overlap it, so that a query
+ only tests a few triangles. Gains are normalized to unit power.
+
+ The magnitude of AEM directions is ignored.
+ */
+template <typename T>
+class VBAP
+{
+public:
+    /**
+     The gains of one direction on at most 3 speakers.
+     */
+    struct SparseGains
+    {
+        int mNumSpeakers;
+        int mSpeakers[3];
+        T   mGains[3];
+    };
+
+    VBAP(const Vector3<T>* pSpeakers, int pNumSpeakers)
+    : mNumSpeakers(pNumSpeakers)
+    , mGrid(8)
+    {
+        for (int i = 0 ; i != pNumSpeakers ; ++i)
+        {
+            mPoints.push_back(pSpeakers[i].normalized());
+        }
+        m2D = std::all_of(mPoints.begin(), mPoints.end(),
+                          [](const Vector3<T>& p) { return std::abs(p.mZ) < (T)1e-3; });
+        if (m2D)
+        {
+            buildPairs();
+        }
+        else
+        {
+            buildTriangles();
+        }
+    }
+
+    VBAP(const AE<T>* pSpeakers, int pNumSpeakers)
+    : VBAP(toVectors(pSpeakers, pNumSpeakers).data(), pNumSpeakers)
+    {
+    }
+
+    int getNumSpeakers() const
+    {
+        return mNumSpeakers;
+    }
+
+    /**
+     The number of speakers including the imaginary ones.
+     */
+    int getNumVirtualSpeakers() const
+    {
+        return (int)mPoints.size();
+    }
+
+    bool is2D() const
+    {
+        return m2D;
+    }
+
+    /**
+     Number of triangles, or of speaker pairs in 2D.
+     */
+    size_t getNumTriangles() const
+    {
+        return mTriangles.size();
+    }
+
+    void computeSparseGains(const Vector3<T>& pDirection, SparseGains& pGains) const
+    {
+        if (m2D)
+        {
+            computePairGains(pDirection, pGains);
+            return;
+        }
+        size_t lCell = mGrid.cellOf(pDirection.isZero() ? Vector3<T>::cartesian((T)1, (T)0, (T)0) : pDirection);
+        T lGains[3];
+        size_t lBest = bestTriangle(pDirection, mCellStarts[lCell], mCellStarts[lCell + 1], lGains);
+        if (lBest == mCellStarts[lCell + 1] || std::min(lGains[0], std::min(lGains[1], lGains[2])) < - (T)1e-4)
+        {
+            lBest = bestTriangle(pDirection, mFallbackStart, mCandidates.size(), lGains);
+        }
+        if (lBest == mCandidates.size())
+        {
+            // no triangle in the layout (e.g. a single speaker)
+            computeNearestSpeakerGains(pDirection, pGains);
+            return;
+        }
+        const Triangle& lTriangle = mTriangles[mCandidates[lBest]];
+        pGains.mNumSpeakers = 0;
+        T lSqrSum = (T)0;
+        for (int v = 0 ; v != 3 ; ++v)
+        {
+            if (lTriangle.mSpeakers[v] < mNumSpeakers)
+            {
+                T lGain = std::max(lGains[v], (T)0);
+                pGains.mSpeakers[pGains.mNumSpeakers] = lTriangle.mSpeakers[v];
+                pGains.mGains[pGains.mNumSpeakers] = lGain;
+                lSqrSum += lGain * lGain;
+                ++pGains.mNumSpeakers;
+            }
+        }
+        normalize(pGains, lSqrSum);
+    }
+
+    void computeSparseGains(const AE<T>& pDirection, SparseGains& pGains) const
+    {
+        computeSparseGains(Vector3<T>::fromAE(pDirection), pGains);
+    }
+
+    void computeSparseGains(const AEM<T>& pDirection, SparseGains& pGains) const
+    {
+        computeSparseGains(AE<T>::fromAEM(pDirection), pGains);
+    }
+
+    /**
+     Dense gains: pGains has getNumSpeakers() elements.
+     */
+    template <class D>
+    void computeGains(const D& pDirection, T* pGains) const
+    {
+        SparseGains lSparse;
+        computeSparseGains(pDirection, lSparse);
+        std::fill(pGains, pGains + mNumSpeakers, (T)0);
+        for (int v = 0 ; v != lSparse.mNumSpeakers ; ++v)
+        {
+            pGains[lSparse.mSpeakers[v]] = lSparse.mGains[v];
+        }
+    }
+
+    template <class D>
+    void computeSparseGainsBatch(const D* pDirections, size_t pNumDirections, SparseGains* pGains) const
+    {
+        for (size_t u = 0 ; u != pNumDirections ; ++u)
+        {
+            computeSparseGains(pDirections[u], pGains[u]);
+        }
+    }
+
+    /**
+     Dense gains of many directions: pGains is direction-major, with
+     getNumSpeakers() gains per direction.
+     */
+    template <class D>
+    void computeGainsBatch(const D* pDirections, size_t pNumDirections, T* pGains) const
+    {
+        for (size_t u = 0 ; u != pNumDirections ; ++u)
+        {
+            computeGains(pDirections[u], pGains + u * (size_t)mNumSpeakers);
+        }
+    }
+
+private:
+    struct Triangle
+    {
+        int        mSpeakers[3];
+        Matrix3<T> mInverse;
+    };
+
+    static std::vector< Vector3<T> > toVectors(const AE<T>* pSpeakers, int pNumSpeakers)
+    {
+        std::vector< Vector3<T> > lVectors((size_t)pNumSpeakers);
+        for (int i = 0 ; i != pNumSpeakers ; ++i)
+        {
+            lVectors[(size_t)i] = Vector3<T>::fromAE(pSpeakers[i]);
+        }
+        return lVectors;
+    }
+
+    static void normalize(SparseGains& pGains, T pSqrSum)
+    {
+        if (pSqrSum > (T)1e-12)
+        {
+            T lInvNorm = mu::finvsqrt(pSqrSum);
+            for (int v = 0 ; v != pGains.mNumSpeakers ; ++v)
+            {
+                pGains.mGains[v] *= lInvNorm;
+            }
+        }
+        else if (pGains.mNumSpeakers > 0)
+        {
+            // on an imaginary speaker: spread over the real ones of the triangle
+            T lGain = mu::finvsqrt((T)pGains.mNumSpeakers);
+            for (int v = 0 ; v != pGains.mNumSpeakers ; ++v)
+            {
+                pGains.mGains[v] = lGain;
+            }
+        }
+    }
+
+    /**
+     Among the candidates [pBegin, pEnd), the triangle whose smallest gain is the
+     largest, i.e. the one that contains the direction most robustly. Returns
+     pEnd if there is no candidate.
+     */
+    size_t bestTriangle(const Vector3<T>& pDirection, size_t pBegin, size_t pEnd, T* pGains) const
+    {
+        size_t lBest = pEnd;
+        T lBestMin = - std::numeric_limits<T>::max();
+        for (size_t u = pBegin ; u != pEnd ; ++u)
+        {
+            Vector3<T> g = mTriangles[mCandidates[u]].mInverse.rotate(pDirection);
+            T lMin = std::min(g.mX, std::min(g.mY, g.mZ));
+            if (lMin > lBestMin)
+            {
+                lBestMin = lMin;
+                lBest = u;
+                pGains[0] = g.mX;
+                pGains[1] = g.mY;
+                pGains[2] = g.mZ;
+                if (lMin >= (T)0)
+                {
+                    break;
+                }
+            }
+        }
+        return lBest;
+    }
+
+    //==========================================================================
+    void buildTriangles()
+    {
+        for (int lIteration = 0 ; lIteration != 4 ; ++lIteration)
+        {
+            computeHull();
+            // probe the sphere for holes, and close them with an imaginary speaker
+            CubeMapGrid<T> lProbes(4);
+            Vector3<T> lHoleSum = Vector3<T>::cartesian((T)0, (T)0, (T)0);
+            for (size_t lCell = 0 ; lCell != lProbes.getNumCells() ; ++lCell)
+            {
+                const Vector3<T>& lProbe = lProbes.getCellCenter(lCell);
+                if (!isCovered(lProbe))
+                {
+                    lHoleSum += lProbe;
+                }
+            }
+            if (lHoleSum.isZero())
+            {
+                break;
+            }
+            mPoints.push_back(lHoleSum.normalizedWithDefault(Vector3<T>::cartesian((T)0, (T)0, (T)(-1))));
+        }
+        buildLookup();
+    }
+
+    bool isCovered(const Vector3<T>& pDirection) const
+    {
+        for (const Triangle& lTriangle : mTriangles)
+        {
+            Vector3<T> g = lTriangle.mInverse.rotate(pDirection);
+            if (std::min(g.mX, std::min(g.mY, g.mZ)) >= - (T)1e-4)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     Brute force convex hull, O(n^4), which is fine for speaker layouts. Faces
+     with more than 3 coplanar speakers are triangulated with the Delaunay
+     criterion, and overlapping triangles (cocircular speakers) are rejected.
+     */
+    void computeHull()
+    {
+        typedef Vector3<double> V;
+        const double lEpsilon = 1e-6;
+        std::vector<V> p(mPoints.size());
+        for (size_t u = 0 ; u != p.size() ; ++u)
+        {
+            p[u] = V::cartesian((double)mPoints[u].mX, (double)mPoints[u].mY, (double)mPoints[u].mZ);
+        }
+        struct Face
+        {
+            int mV[3];
+            V   mNormal;
+            double mOffset;
+            bool mHasCoplanar;
+        };
+        std::vector<Face> lFaces;
+        const int n = (int)p.size();
+        for (int i = 0 ; i < n ; ++i)
+        {
+            for (int j = i + 1 ; j < n ; ++j)
+            {
+                for (int k = j + 1 ; k < n ; ++k)
+                {
+                    V lNormal = (p[j] - p[i]).cross(p[k] - p[i]);
+                    if (lNormal.sqrLength() < lEpsilon * lEpsilon)
+                    {
+                        continue; // aligned
+                    }
+                    lNormal.normalize();
+                    double lOffset = lNormal.dot(p[i]);
+                    if (lOffset < 0.)
+                    {
+                        lNormal *= -1.;
+                        lOffset = -lOffset;
+                    }
+                    if (lOffset < 1e-3)
+                    {
+                        continue; // plane through the listener: cannot pan
+                    }
+                    bool lIsFace = true;
+                    bool lHasCoplanar = false;
+                    for (int l = 0 ; l < n && lIsFace ; ++l)
+                    {
+                        if (l == i || l == j || l == k)
+                        {
+                            continue;
+                        }
+                        double lDistance = lNormal.dot(p[l]) - lOffset;
+                        if (lDistance > lEpsilon)
+                        {
+                            lIsFace = false;
+                        }
+                        else if (lDistance > - lEpsilon)
+                        {
+                            lHasCoplanar = true;
+                            lIsFace = !insideCircumcircle(p[i], p[j], p[k], p[l]);
+                        }
+                    }
+                    if (lIsFace)
+                    {
+                        lFaces.push_back({{i, j, k}, lNormal, lOffset, lHasCoplanar});
+                    }
+                }
+            }
+        }
+
+        mTriangles.clear();
+        std::vector<size_t> lAccepted;
+        for (size_t f = 0 ; f != lFaces.size() ; ++f)
+        {
+            const Face& lFace = lFaces[f];
+            bool lOverlaps = false;
+            if (lFace.mHasCoplanar)
+            {
+                for (size_t a : lAccepted)
+                {
+                    const Face& lOther = lFaces[a];
+                    if (lOther.mHasCoplanar
+                        && lOther.mNormal.dot(lFace.mNormal) > 1. - lEpsilon
+                        && overlap(p, lFace.mV, lOther.mV, lFace.mNormal))
+                    {
+                        lOverlaps = true;
+                        break;
+                    }
+                }
+            }
+            if (!lOverlaps)
+            {
+                lAccepted.push_back(f);
+                addTriangle(lFace.mV[0], lFace.mV[1], lFace.mV[2]);
+            }
+        }
+    }
+
+    static bool insideCircumcircle(const Vector3<double>& pA, const Vector3<double>& pB,
+                                   const Vector3<double>& pC, const Vector3<double>& pQ)
+    {
+        Vector3<double> a = pB - pA;
+        Vector3<double> b = pC - pA;
+        Vector3<double> lAxB = a.cross(b);
+        Vector3<double> lCenter = pA + (0.5 / lAxB.sqrLength()) * ((a.sqrLength() * b - b.sqrLength() * a).cross(lAxB));
+        return (pQ - lCenter).sqrLength() < (pA - lCenter).sqrLength() - 1e-9;
+    }
+
+    /**
+     Whether two coplanar triangles have overlapping interiors.
+     */
+    static bool overlap(const std::vector< Vector3<double> >& p, const int* pA, const int* pB, const Vector3<double>& pNormal)
+    {
+        // orientation of pQ relative to the edge pU -> pV, in the plane
+        auto lSide = [&pNormal](const Vector3<double>& pU, const Vector3<double>& pV, const Vector3<double>& pQ) {
+            return pNormal.dot((pV - pU).cross(pQ - pU));
+        };
+        auto lStrictlyInside = [&](const int* pT, const Vector3<double>& pQ) {
+            double s0 = lSide(p[pT[0]], p[pT[1]], pQ);
+            double s1 = lSide(p[pT[1]], p[pT[2]], pQ);
+            double s2 = lSide(p[pT[2]], p[pT[0]], pQ);
+            return (s0 > 1e-9 && s1 > 1e-9 && s2 > 1e-9) || (s0 < -1e-9 && s1 < -1e-9 && s2 < -1e-9);
+        };
+        Vector3<double> lCentroidA = (1. / 3.) * (p[pA[0]] + p[pA[1]] + p[pA[2]]);
+        Vector3<double> lCentroidB = (1. / 3.) * (p[pB[0]] + p[pB[1]] + p[pB[2]]);
+        if (lStrictlyInside(pA, lCentroidB) || lStrictlyInside(pB, lCentroidA))
+        {
+            return true;
+        }
+        for (int e = 0 ; e != 3 ; ++e)
+        {
+            const Vector3<double>& a0 = p[pA[e]];
+            const Vector3<double>& a1 = p[pA[(e + 1) % 3]];
+            for (int f = 0 ; f != 3 ; ++f)
+            {
+                const Vector3<double>& b0 = p[pB[f]];
+                const Vector3<double>& b1 = p[pB[(f + 1) % 3]];
+                double d0 = lSide(a0, a1, b0);
+                double d1 = lSide(a0, a1, b1);
+                double d2 = lSide(b0, b1, a0);
+                double d3 = lSide(b0, b1, a1);
+                if (((d0 > 1e-9 && d1 < -1e-9) || (d0 < -1e-9 && d1 > 1e-9))
+                    && ((d2 > 1e-9 && d3 < -1e-9) || (d2 < -1e-9 && d3 > 1e-9)))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void addTriangle(int pA, int pB, int pC)
+    {
+        const Vector3<T>& a = mPoints[(size_t)pA];
+        const Vector3<T>& b = mPoints[(size_t)pB];
+        const Vector3<T>& c = mPoints[(size_t)pC];
+        // columns are the speaker vectors: p = L.g, so g = L^-1.p
+        Matrix3<T> lL = {{{a.mX, b.mX, c.mX},
+                          {a.mY, b.mY, c.mY},
+                          {a.mZ, b.mZ, c.mZ}}};
+        Triangle lTriangle;
+        if (lL.inverse(lTriangle.mInverse))
+        {
+            lTriangle.mSpeakers[0] = pA;
+            lTriangle.mSpeakers[1] = pB;
+            lTriangle.mSpeakers[2] = pC;
+            mTriangles.push_back(lTriangle);
+        }
+    }
+
+    void buildLookup()
+    {
+        mCellStarts.assign(mGrid.getNumCells() + 1, 0);
+        mCandidates.clear();
+        std::vector< Vector3<T> > lCenters(mTriangles.size());
+        std::vector<T> lRadii(mTriangles.size());
+        for (size_t t = 0 ; t != mTriangles.size() ; ++t)
+        {
+            const int* v = mTriangles[t].mSpeakers;
+            lCenters[t] = (mPoints[(size_t)v[0]] + mPoints[(size_t)v[1]] + mPoints[(size_t)v[2]]).normalized();
+            T lMinCos = (T)1;
+            for (int u = 0 ; u != 3 ; ++u)
+            {
+                lMinCos = std::min(lMinCos, lCenters[t].dot(mPoints[(size_t)v[u]]));
+            }
+            // a cap wider than a hemisphere does not contain its triangle: match everything
+            lRadii[t] = lMinCos > (T)0.01 ? std::acos(lMinCos) : (T)(2. * M_PI);
+        }
+        for (size_t lCell = 0 ; lCell != mGrid.getNumCells() ; ++lCell)
+        {
+            mCellStarts[lCell] = mCandidates.size();
+            const Vector3<T>& lCellCenter = mGrid.getCellCenter(lCell);
+            for (size_t t = 0 ; t != mTriangles.size() ; ++t)
+            {
+                T lAngle = std::acos(mu::limitedRange(lCellCenter.dot(lCenters[t]), (T)(-1), (T)1));
+                if (lAngle <= lRadii[t] + mGrid.getCellAngularRadius(lCell) + (T)1e-3)
+                {
+                    mCandidates.push_back(t);
+                }
+            }
+        }
+        mCellStarts[mGrid.getNumCells()] = mCandidates.size();
+        // the full scan fallback goes through mCandidates too: append all triangles
+        mFallbackStart = mCandidates.size();
+        for (size_t t = 0 ; t != mTriangles.size() ; ++t)
+        {
+            mCandidates.push_back(t);
+        }
+    }
+
+    //==========================================================================
+    void buildPairs()
+    {
+        std::vector<int> lOrder((size_t)mNumSpeakers);
+        for (int i = 0 ; i != mNumSpeakers ; ++i)
+        {
+            lOrder[(size_t)i] = i;
+        }
+        std::sort(lOrder.begin(), lOrder.end(), [this](int a, int b) {
+            return std::atan2(mPoints[(size_t)a].mY, mPoints[(size_t)a].mX)
+                 < std::atan2(mPoints[(size_t)b].mY, mPoints[(size_t)b].mX);
+        });
+        for (int i = 0 ; i != mNumSpeakers && mNumSpeakers > 1 ; ++i)
+        {
+            int a = lOrder[(size_t)i];
+            int b = lOrder[(size_t)((i + 1) % mNumSpeakers)];
+            const Vector3<T>& pa = mPoints[(size_t)a];
+            const Vector3<T>& pb = mPoints[(size_t)b];
+            // pairs spanning more than π cannot pan
+            T lCross = pa.mX * pb.mY - pa.mY * pb.mX;
+            if (lCross <= (T)1e-6)
+            {
+                continue;
+            }
+            // 2x2 inverse stored in the upper-left corner, z passes through
+            T lInvDet = (T)1 / lCross;
+            Triangle lPair;
+            lPair.mSpeakers[0] = a;
+            lPair.mSpeakers[1] = b;
+            lPair.mSpeakers[2] = -1;
+            lPair.mInverse = {{{pb.mY * lInvDet, - pb.mX * lInvDet, (T)0},
+                               {- pa.mY * lInvDet, pa.mX * lInvDet, (T)0},
+                               {(T)0, (T)0, (T)1}}};
+            mTriangles.push_back(lPair);
+        }
+    }
+
+    void computePairGains(const Vector3<T>& pDirection, SparseGains& pGains) const
+    {
+        Vector3<T> lFlat = Vector3<T>::cartesian(pDirection.mX, pDirection.mY, (T)0);
+        pGains.mNumSpeakers = 0;
+        T lBestMin = - std::numeric_limits<T>::max();
+        for (const Triangle& lPair : mTriangles)
+        {
+            Vector3<T> g = lPair.mInverse.rotate(lFlat);
+            T lMin = std::min(g.mX, g.mY);
+            if (lMin > lBestMin)
+            {
+                lBestMin = lMin;
+                pGains.mNumSpeakers = 2;
+                pGains.mSpeakers[0] = lPair.mSpeakers[0];
+                pGains.mSpeakers[1] = lPair.mSpeakers[1];
+                pGains.mGains[0] = std::max(g.mX, (T)0);
+                pGains.mGains[1] = std::max(g.mY, (T)0);
+            }
+        }
+        if (lBestMin < - (T)1e-4 || lFlat.isZero())
+        {
+            // in a gap wider than π, or above the listener: nearest speaker
+            computeNearestSpeakerGains(lFlat, pGains);
+            return;
+        }
+        normalize(pGains, pGains.mGains[0] * pGains.mGains[0] + pGains.mGains[1] * pGains.mGains[1]);
+    }
+
+    void computeNearestSpeakerGains(const Vector3<T>& pDirection, SparseGains& pGains) const
+    {
+        pGains.mNumSpeakers = 0;
+        if (mNumSpeakers > 0)
+        {
+            int lNearest = 0;
+            for (int i = 1 ; i != mNumSpeakers ; ++i)
+            {
+                if (mPoints[(size_t)i].dot(pDirection) > mPoints[(size_t)lNearest].dot(pDirection))
+                {
+                    lNearest = i;
+                }
+            }
+            pGains.mNumSpeakers = 1;
+            pGains.mSpeakers[0] = lNearest;
+            pGains.mGains[0] = (T)1;
+        }
+    }
+
+    int                       mNumSpeakers;
+    bool                      m2D;
+    std::vector< Vector3<T> > mPoints;    ///< real speakers, then imaginary ones
+    std::vector<Triangle>     mTriangles; ///< or pairs in 2D
+    CubeMapGrid<T>            mGrid;
+    std::vector<size_t>       mCellStarts;
+    std::vector<size_t>       mCandidates;
+    size_t                    mFallbackStart = 0;
+};
+
+typedef VBAP<float> VBAPf;
+
+}
+
+#endif
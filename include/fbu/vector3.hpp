@@ -279,7 +279,7 @@ struct AEM
     static AEM<T> fromVector3(const Vector3<T>& pVect)
     {
         AEM lAEM;
-        float lNorm2D;
+        T lNorm2D;
         pVect.lengthes(lAEM.mMagnitude, lNorm2D);
         lAEM.mAzimuth = std::atan2(pVect.mY, pVect.mX);
         lAEM.mElevation = std::atan2(pVect.mZ, lNorm2D);
@@ -359,7 +359,7 @@ void Vector3_to_AEMr(const Vector3<T>& pVect, AEMr<T>& pAEM)
 {
     pAEM.mAzimuth = 0.f;
     pAEM.mElevation = 0.f;
-    float lMagnitude2D = std::hypot(pVect.mX, pVect.mY);
+    T lMagnitude2D = std::hypot(pVect.mX, pVect.mY);
     pAEM.mMagnitude = std::hypot(lMagnitude2D, pVect.mZ);
     if (pAEM.mMagnitude != 0.f)
     {
@@ -388,10 +388,10 @@ template <typename T>
 Vector3<T> Vector3<T>::fromAEMr(const AEMr<T>& pAEM)
 {
     Vector3<T> lVect;
-    float lCosAzimuth = std::cos(pAEM.mAzimuth);
-    float lSinAzimuth = std::sin(pAEM.mAzimuth);
-    float lCosElevation = std::cos(pAEM.mElevation);
-    float lSinElevation = std::sin(pAEM.mElevation);
+    T lCosAzimuth = std::cos(pAEM.mAzimuth);
+    T lSinAzimuth = std::sin(pAEM.mAzimuth);
+    T lCosElevation = std::cos(pAEM.mElevation);
+    T lSinElevation = std::sin(pAEM.mElevation);
     lVect.mX = pAEM.mMagnitude * lCosElevation * lCosAzimuth;
     lVect.mY = - pAEM.mMagnitude * lCosElevation * lSinAzimuth;
     lVect.mZ = pAEM.mMagnitude * lSinElevation;
@@ -404,15 +404,15 @@ Vector3<T> Vector3<T>::fromAEM(const AEM<T>& pAEM)
 {
     Vector3<T> lVect;
 #ifdef __EMSCRIPTEN__
-    float lCosAzimuth = mu::fastCos8(pAEM.mAzimuth);
-    float lSinAzimuth = mu::fastSin9(pAEM.mAzimuth);
-    float lCosElevation = mu::fastCos8(pAEM.mElevation);
-    float lSinElevation = mu::fastSin9(pAEM.mElevation);
+    T lCosAzimuth = (T)mu::fastCos8((float)pAEM.mAzimuth);
+    T lSinAzimuth = (T)mu::fastSin9((float)pAEM.mAzimuth);
+    T lCosElevation = (T)mu::fastCos8((float)pAEM.mElevation);
+    T lSinElevation = (T)mu::fastSin9((float)pAEM.mElevation);
 #else
-    float lCosAzimuth = std::cos(pAEM.mAzimuth);
-    float lSinAzimuth = std::sin(pAEM.mAzimuth);
-    float lCosElevation = std::cos(pAEM.mElevation);
-    float lSinElevation = std::sin(pAEM.mElevation);
+    T lCosAzimuth = std::cos(pAEM.mAzimuth);
+    T lSinAzimuth = std::sin(pAEM.mAzimuth);
+    T lCosElevation = std::cos(pAEM.mElevation);
+    T lSinElevation = std::sin(pAEM.mElevation);
 #endif
     lVect.mX = pAEM.mMagnitude * lCosElevation * lCosAzimuth;
     lVect.mY = pAEM.mMagnitude * lCosElevation * lSinAzimuth;
@@ -426,15 +426,15 @@ Vector3<T> Vector3<T>::fromAE(const AE<T>& pAE)
 {
     Vector3<T> lVect;
 #ifdef __EMSCRIPTEN__
-    float lCosAzimuth = mu::fastCos8(pAE.mAzimuth);
-    float lSinAzimuth = mu::fastSin9(pAE.mAzimuth);
-    float lCosElevation = mu::fastCos8(pAE.mElevation);
-    float lSinElevation = mu::fastSin9(pAE.mElevation);
+    T lCosAzimuth = (T)mu::fastCos8((float)pAE.mAzimuth);
+    T lSinAzimuth = (T)mu::fastSin9((float)pAE.mAzimuth);
+    T lCosElevation = (T)mu::fastCos8((float)pAE.mElevation);
+    T lSinElevation = (T)mu::fastSin9((float)pAE.mElevation);
 #else
-    float lCosAzimuth = std::cos(pAE.mAzimuth);
-    float lSinAzimuth = std::sin(pAE.mAzimuth);
-    float lCosElevation = std::cos(pAE.mElevation);
-    float lSinElevation = std::sin(pAE.mElevation);
+    T lCosAzimuth = std::cos(pAE.mAzimuth);
+    T lSinAzimuth = std::sin(pAE.mAzimuth);
+    T lCosElevation = std::cos(pAE.mElevation);
+    T lSinElevation = std::sin(pAE.mElevation);
 #endif
     lVect.mX = lCosElevation * lCosAzimuth;
     lVect.mY = lCosElevation * lSinAzimuth;
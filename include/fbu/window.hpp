@@ -0,0 +1,86 @@
+#ifndef FBU_WINDOW_HPP_INCLUDED
+#define FBU_WINDOW_HPP_INCLUDED
+
+/**
+ @file window.hpp
+ @author François Becker
+
+MIT License
+
+Copyright (c) 2026 François Becker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cmath>
+#include <cstddef>
+
+namespace fbu
+{
+
+enum class WindowType
+{
+    Rectangular,
+    Hann,
+    SqrtHann,
+    Hamming,
+    Blackman,
+    BlackmanHarris
+};
+
+//==============================================================================
+/**
+ Fill pOut with a periodic window of pSize samples (the DFT-even form used for
+ spectral analysis and overlap-add, whose period is pSize).
+ */
+template <typename T>
+void fillWindow(WindowType pType, T* pOut, size_t pSize)
+{
+    for (size_t i = 0 ; i != pSize ; ++i)
+    {
+        double x = 2. * M_PI * (double)i / (double)pSize;
+        double w = 1.;
+        switch (pType)
+        {
+            case WindowType::Rectangular:
+                w = 1.;
+                break;
+            case WindowType::Hann:
+                w = 0.5 - 0.5 * std::cos(x);
+                break;
+            case WindowType::SqrtHann:
+                w = std::sqrt(0.5 - 0.5 * std::cos(x));
+                break;
+            case WindowType::Hamming:
+                w = 0.54 - 0.46 * std::cos(x);
+                break;
+            case WindowType::Blackman:
+                w = 0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2. * x);
+                break;
+            case WindowType::BlackmanHarris:
+                w = 0.35875 - 0.48829 * std::cos(x) + 0.14128 * std::cos(2. * x) - 0.01168 * std::cos(3. * x);
+                break;
+        }
+        pOut[i] = (T)w;
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,47 @@
+#include "fbu/aligned_buffer.hpp"
+#include "fbu/complex.hpp"
+
+#include "tests_common.hpp"
+
+#include <cstdint>
+
+CASE("AlignedBuffer: data is aligned and zeroed")
+{
+    for (size_t lSize = 1 ; lSize < 100 ; lSize += 7)
+    {
+        fbu::AlignedBuffer<float> lFloats(lSize);
+        EXPECT(lFloats.size() == lSize);
+        EXPECT(reinterpret_cast<uintptr_t>(lFloats.data()) % 64 == 0);
+        for (size_t u = 0 ; u != lSize ; ++u)
+        {
+            EXPECT(lFloats[u] == 0.f);
+        }
+        fbu::AlignedBuffer<Complexd, 32> lComplexes(lSize);
+        EXPECT(reinterpret_cast<uintptr_t>(lComplexes.data()) % 32 == 0);
+        EXPECT(lComplexes[lSize - 1] == Complexd({0., 0.}));
+    }
+    fbu::AlignedBuffer<float> lEmpty;
+    EXPECT(lEmpty.size() == 0u);
+    EXPECT(lEmpty.begin() == lEmpty.end());
+}
+
+CASE("AlignedBuffer: copy and move")
+{
+    fbu::AlignedBuffer<int> lBuffer(10);
+    for (size_t u = 0 ; u != lBuffer.size() ; ++u)
+    {
+        lBuffer[u] = (int)u;
+    }
+    fbu::AlignedBuffer<int> lCopy(lBuffer);
+    EXPECT(lCopy.data() != lBuffer.data());
+    EXPECT(lCopy[9] == 9);
+    fbu::AlignedBuffer<int> lMoved(std::move(lCopy));
+    EXPECT(lMoved[9] == 9);
+    EXPECT(lCopy.size() == 0u);
+    lCopy = lMoved;
+    EXPECT(lCopy[5] == 5);
+    lCopy.clear();
+    EXPECT(lCopy[5] == 0);
+    lCopy.resize(3);
+    EXPECT(lCopy.size() == 3u);
+}
@@ -1 +1,126 @@
 #include "fbu/complex.hpp"
+#include "fbu/stopwatch.hpp"
+
+#include "tests_common.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <iostream>
+#include <random>
+#include <vector>
+
+CASE("Complex: arithmetic operators")
+{
+    Complexd a = {1., 2.};
+    Complexd b = {3., -4.};
+    EXPECT(a + b == Complexd({4., -2.}));
+    EXPECT(a - b == Complexd({-2., 6.}));
+    EXPECT(a * b == Complexd({11., 2.}));
+    EXPECT(2. * a == Complexd({2., 4.}));
+    Complexd q = a / b;
+    EXPECT(q.re == lest::approx(-0.2));
+    EXPECT(q.im == lest::approx(0.4));
+    EXPECT((q * b - a).mag() < 1e-12);
+    EXPECT((a.inverse() * a - Complexd({1., 0.})).mag() < 1e-12);
+    EXPECT(b.mag() == lest::approx(5.));
+    EXPECT(b.sqrmag() == lest::approx(25.));
+}
+
+CASE("Complex: compound assignment matches the binary operators")
+{
+    Complexd a = {1., 2.};
+    Complexd b = {3., -4.};
+    Complexd c = a;
+    c /= b;
+    EXPECT((c - a / b).mag() < 1e-15);
+    c = a;
+    c *= b;
+    EXPECT(c == a * b);
+    c = a;
+    c /= 4.;
+    EXPECT(c == Complexd({0.25, 0.5}));
+    // the scalar division keeps double precision
+    Complexd d = {1., 0.};
+    d /= 3.;
+    EXPECT(d.re == 1. / 3.);
+    Complexf f = {1.f, 1.f};
+    f /= Complexf({0.f, 2.f});
+    EXPECT(f.re == lest::approx(0.5f));
+    EXPECT(f.im == lest::approx(-0.5f));
+}
+
+namespace
+{
+    /**
+     Each run works on a fresh copy of pA, made outside the timed region, so
+     that the in-place kernels never drift to inf or NaN.
+     */
+    template <class C>
+    void benchmark(const char* pName, const std::vector<C>& pA, const std::vector<C>& b,
+                   void (*pKernel)(std::vector<C>&, const std::vector<C>&))
+    {
+        const int lNumRuns = 200;
+        std::vector<C> a(pA.size());
+        double lSeconds = 0.;
+        StopWatch lSW;
+        for (int r = 0 ; r != lNumRuns ; ++r)
+        {
+            std::copy(pA.begin(), pA.end(), a.begin());
+            lSW.start();
+            pKernel(a, b);
+            lSW.stop();
+            lSeconds += lSW.getSeconds();
+        }
+        double lNs = 1e9 * lSeconds / ((double)lNumRuns * (double)a.size());
+        std::cout << "  " << pName << ": " << lNs << " ns per element" << std::endl;
+    }
+    
+    template <typename T, class C>
+    void runBenchmarks(const char* pName, const std::vector<C>& a, const std::vector<C>& b)
+    {
+        std::cout << pName << std::endl;
+        benchmark<C>("a = a * b", a, b, [](std::vector<C>& x, const std::vector<C>& y) {
+            for (size_t u = 0 ; u != x.size() ; ++u) { x[u] = x[u] * y[u]; } });
+        benchmark<C>("a += a * b", a, b, [](std::vector<C>& x, const std::vector<C>& y) {
+            for (size_t u = 0 ; u != x.size() ; ++u) { x[u] += x[u] * y[u]; } });
+        benchmark<C>("a /= b", a, b, [](std::vector<C>& x, const std::vector<C>& y) {
+            for (size_t u = 0 ; u != x.size() ; ++u) { x[u] /= y[u]; } });
+        benchmark<C>("a = a / b", a, b, [](std::vector<C>& x, const std::vector<C>& y) {
+            for (size_t u = 0 ; u != x.size() ; ++u) { x[u] = x[u] / y[u]; } });
+        benchmark<C>("a *= s", a, b, [](std::vector<C>& x, const std::vector<C>&) {
+            for (size_t u = 0 ; u != x.size() ; ++u) { x[u] *= (T)0.999; } });
+        benchmark<C>("a -= b", a, b, [](std::vector<C>& x, const std::vector<C>& y) {
+            for (size_t u = 0 ; u != x.size() ; ++u) { x[u] -= y[u]; } });
+    }
+    
+    template <typename T>
+    void runComparison()
+    {
+        const size_t n = 1 << 16;
+        std::mt19937 lRandomGenerator(1);
+        std::uniform_real_distribution<T> lDistribution((T)0.5, (T)1);
+        std::vector< std::complex<T> > lStdA(n), lStdB(n);
+        std::vector< Complex<T> > lA(n), lB(n);
+        for (size_t u = 0 ; u != n ; ++u)
+        {
+            lA[u] = {lDistribution(lRandomGenerator), lDistribution(lRandomGenerator)};
+            lB[u] = {lDistribution(lRandomGenerator), lDistribution(lRandomGenerator)};
+            lStdA[u] = {lA[u].re, lA[u].im};
+            lStdB[u] = {lB[u].re, lB[u].im};
+        }
+        runBenchmarks<T>(sizeof(T) == 4 ? "std::complex<float>" : "std::complex<double>", lStdA, lStdB);
+        runBenchmarks<T>(sizeof(T) == 4 ? "Complex<float>" : "Complex<double>", lA, lB);
+        
+        std::cout << "  vector helpers" << std::endl;
+        benchmark< Complex<T> >("vectProductSC_I", lA, lB, [](std::vector< Complex<T> >& x, const std::vector< Complex<T> >&) {
+            vectProductSC_I((T)0.999, x.data(), x.size()); });
+        benchmark< Complex<T> >("vectSubtract_I", lA, lB, [](std::vector< Complex<T> >& x, const std::vector< Complex<T> >& y) {
+            vectSubtract_I(y.data(), x.data(), x.size()); });
+    }
+}
+
+CASE("Complex: benchmark against std::complex" "[.bench]")
+{
+    runComparison<float>();
+    runComparison<double>();
+}
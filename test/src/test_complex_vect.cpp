@@ -0,0 +1,148 @@
+#include "fbu/complex_vect.hpp"
+#include "fbu/stopwatch.hpp"
+
+#include "tests_common.hpp"
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    template <typename T>
+    void checkKernels(lest::env& lest_env, T pTolerance)
+    {
+        // odd size to go through the scalar tail of the SIMD loops
+        const size_t n = 67;
+        std::vector< Complex<T> > a = randomComplexes<T>(n, 1);
+        std::vector< Complex<T> > b = randomComplexes<T>(n, 2);
+        std::vector< Complex<T> > c = randomComplexes<T>(n, 3);
+        std::vector< Complex<T> > lOut(n);
+        
+        auto lClose = [pTolerance](Complex<T> x, Complex<T> y) { return (x - y).mag() < pTolerance; };
+        
+        vectMultiply(a.data(), b.data(), lOut.data(), n);
+        for (size_t u = 0 ; u != n ; ++u)
+        {
+            EXPECT(lClose(lOut[u], a[u] * b[u]));
+        }
+        
+        lOut = c;
+        vectMultiplyAccumulate(a.data(), b.data(), lOut.data(), n);
+        for (size_t u = 0 ; u != n ; ++u)
+        {
+            EXPECT(lClose(lOut[u], c[u] + a[u] * b[u]));
+        }
+        
+        lOut = c;
+        vectConjMultiplyAccumulate(a.data(), b.data(), lOut.data(), n);
+        for (size_t u = 0 ; u != n ; ++u)
+        {
+            EXPECT(lClose(lOut[u], c[u] + a[u] * b[u].conj()));
+        }
+        
+        lOut = c;
+        vectScaleAdd((T)0.5, a.data(), lOut.data(), n);
+        for (size_t u = 0 ; u != n ; ++u)
+        {
+            EXPECT(lClose(lOut[u], c[u] + (T)0.5 * a[u]));
+        }
+        
+        vectDivideRegularized(a.data(), b.data(), (T)0, lOut.data(), n);
+        for (size_t u = 0 ; u != n ; ++u)
+        {
+            EXPECT(lClose(lOut[u] * b[u], a[u]));
+        }
+        
+        // a vanishing divisor gives zero
+        b[5] = {(T)0, (T)0};
+        vectDivideRegularized(a.data(), b.data(), (T)1e-6, lOut.data(), n);
+        EXPECT(lOut[5] == Complex<T>({(T)0, (T)0}));
+        
+        // in place
+        lOut = a;
+        vectMultiply(lOut.data(), b.data(), lOut.data(), n);
+        EXPECT(lClose(lOut[n - 1], a[n - 1] * b[n - 1]));
+    }
+}
+
+CASE("Complex vect: kernels match Complex arithmetic")
+{
+    checkKernels<float>(lest_env, 1e-4f);
+    checkKernels<double>(lest_env, 1e-12);
+}
+
+namespace
+{
+    template<typename T>
+    void benchmarkMultiplyAccumulate(const char* pName)
+    {
+        const size_t n = 4096;
+        std::vector< Complex<T> > a = randomComplexes<T>(n, 1);
+        std::vector< Complex<T> > b = randomComplexes<T>(n, 2);
+        std::vector< Complex<T> > lAcc(n, {(T)0, (T)0});
+        const int lNumRuns = 10000;
+        StopWatch lSW;
+        lSW.start();
+        for (int r = 0 ; r != lNumRuns ; ++r)
+        {
+            vectMultiplyAccumulate(a.data(), b.data(), lAcc.data(), n);
+        }
+        lSW.stop();
+        std::cout << "vectMultiplyAccumulate " << pName << " " << n << ": " << 1e9 * lSW.getSeconds() / lNumRuns << " ns" << std::endl;
+        lSW.start();
+        for (int r = 0 ; r != lNumRuns ; ++r)
+        {
+            vectMultiplyAccumulate<T>(a.data(), b.data(), lAcc.data(), n);
+        }
+        lSW.stop();
+        std::cout << "vectMultiplyAccumulate " << pName << " (portable) " << n << ": " << 1e9 * lSW.getSeconds() / lNumRuns << " ns" << std::endl;
+    }
+}
+
+CASE("Complex vect: benchmark" "[.bench]")
+{
+    benchmarkMultiplyAccumulate<float>("float");
+    benchmarkMultiplyAccumulate<double>("double");
+}
+
+CASE("Complex vect: polar kernels")
+{
+    const size_t n = 67;
+    std::vector<Complexf> a = randomComplexes<float>(n, 4);
+    a[3] = {0.f, 0.f};
+    a[4] = {-1.f, 0.f};
+    std::vector<float> lMagnitudes(n), lSqrMagnitudes(n), lDB(n), lFastDB(n), lPhases(n), lFastPhases(n);
+    vectMagnitude(a.data(), lMagnitudes.data(), n);
+    vectSqrMagnitude(a.data(), lSqrMagnitudes.data(), n);
+    vectMagnitudeDB(a.data(), lDB.data(), n, -120.f);
+    vectFastMagnitudeDB(a.data(), lFastDB.data(), n, -120.f);
+    vectPhase(a.data(), lPhases.data(), n);
+    vectFastPhase(a.data(), lFastPhases.data(), n);
+    for (size_t u = 0 ; u != n ; ++u)
+    {
+        EXPECT(lMagnitudes[u] == lest::approx(a[u].mag()));
+        EXPECT(lSqrMagnitudes[u] == lest::approx(a[u].sqrmag()));
+        EXPECT(lPhases[u] == lest::approx(a[u].arg()));
+        EXPECT(std::abs(lFastPhases[u] - a[u].arg()) < 1e-5f);
+        // fast_log10 is a coarse approximation, with an error growing with the level
+        EXPECT(std::abs(lFastDB[u] - lDB[u]) < 0.05f + 0.005f * std::abs(lDB[u]));
+        if (u != 3)
+        {
+            EXPECT(lDB[u] == lest::approx(20.f * std::log10(a[u].mag())));
+        }
+    }
+    EXPECT(lDB[3] == lest::approx(-120.f));
+    EXPECT(lFastPhases[4] == lest::approx(M_PIf));
+    
+    // back to rectangular, including phases out of )-π,π)
+    lPhases[5] += 4.f * M_PIf;
+    lPhases[6] -= 6.f * M_PIf;
+    std::vector<Complexf> lRect(n), lFastRect(n);
+    vectPolarToRect(lMagnitudes.data(), lPhases.data(), lRect.data(), n);
+    vectFastPolarToRect(lMagnitudes.data(), lPhases.data(), lFastRect.data(), n);
+    for (size_t u = 0 ; u != n ; ++u)
+    {
+        EXPECT((lRect[u] - a[u]).mag() < 1e-5f);
+        EXPECT((lFastRect[u] - a[u]).mag() < 1e-3f);
+    }
+}
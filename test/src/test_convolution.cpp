@@ -0,0 +1,171 @@
+#include "fbu/convolution.hpp"
+#include "fbu/stopwatch.hpp"
+
+#include "tests_common.hpp"
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    std::vector<float> directConvolution(const std::vector<float>& pSignal, const std::vector<float>& pIR)
+    {
+        std::vector<float> lOut(pSignal.size(), 0.f);
+        for (size_t n = 0 ; n != pSignal.size() ; ++n)
+        {
+            double lSum = 0.;
+            for (size_t k = 0 ; k != pIR.size() && k <= n ; ++k)
+            {
+                lSum += (double)pIR[k] * (double)pSignal[n - k];
+            }
+            lOut[n] = (float)lSum;
+        }
+        return lOut;
+    }
+}
+
+CASE("UniformConvolver: processBlock matches direct convolution on every channel")
+{
+    const size_t lBlockSize = 64;
+    std::vector<float> lIR = randomSignal<float>(1000, 1);
+    auto lPreprocessed = std::make_shared<const fbu::ConvolutionIRf>(lIR.data(), lIR.size(), lBlockSize);
+    EXPECT(lPreprocessed->getNumPartitions() == 16u);
+    
+    fbu::UniformConvolverf lConvolver(lPreprocessed, 2);
+    std::vector<float> lSignals[2] = {randomSignal<float>(40 * lBlockSize, 2), randomSignal<float>(40 * lBlockSize, 3)};
+    std::vector<float> lOutputs[2] = {std::vector<float>(lSignals[0].size()), std::vector<float>(lSignals[1].size())};
+    for (size_t b = 0 ; b != 40 ; ++b)
+    {
+        for (int c = 0 ; c != 2 ; ++c)
+        {
+            lConvolver.processBlock(c, lSignals[c].data() + b * lBlockSize, lOutputs[c].data() + b * lBlockSize);
+        }
+    }
+    for (int c = 0 ; c != 2 ; ++c)
+    {
+        std::vector<float> lExpected = directConvolution(lSignals[c], lIR);
+        float lMaxError = 0.f;
+        for (size_t n = 0 ; n != lExpected.size() ; ++n)
+        {
+            lMaxError = std::max(lMaxError, std::abs(lOutputs[c][n] - lExpected[n]));
+        }
+        EXPECT(lMaxError < 1e-3f);
+    }
+}
+
+CASE("UniformConvolver: process handles any buffer size with one block of latency")
+{
+    const size_t lBlockSize = 32;
+    std::vector<float> lIR = randomSignal<float>(100, 4);
+    fbu::UniformConvolverf lConvolver(std::make_shared<const fbu::ConvolutionIRf>(lIR.data(), lIR.size(), lBlockSize), 1);
+    EXPECT(lConvolver.getLatency() == lBlockSize);
+    std::vector<float> lSignal = randomSignal<float>(1000, 5);
+    std::vector<float> lOutput(lSignal.size());
+    size_t lSizes[] = {1, 7, 32, 100, 3};
+    size_t lPosition = 0;
+    for (size_t i = 0 ; lPosition != lSignal.size() ; ++i)
+    {
+        size_t n = std::min(lSizes[i % 5], lSignal.size() - lPosition);
+        lConvolver.process(0, lSignal.data() + lPosition, lOutput.data() + lPosition, n);
+        lPosition += n;
+    }
+    std::vector<float> lExpected = directConvolution(lSignal, lIR);
+    float lMaxError = 0.f;
+    for (size_t n = 0 ; n != lBlockSize ; ++n)
+    {
+        lMaxError = std::max(lMaxError, std::abs(lOutput[n]));
+    }
+    for (size_t n = lBlockSize ; n != lSignal.size() ; ++n)
+    {
+        lMaxError = std::max(lMaxError, std::abs(lOutput[n] - lExpected[n - lBlockSize]));
+    }
+    EXPECT(lMaxError < 1e-4f);
+    
+    // reset clears the tail
+    lConvolver.reset();
+    std::vector<float> lSilence(200, 0.f);
+    lConvolver.process(0, lSilence.data(), lSilence.data(), lSilence.size());
+    EXPECT(*std::max_element(lSilence.begin(), lSilence.end()) == 0.f);
+}
+
+CASE("UniformConvolver: benchmark" "[.bench]")
+{
+    const size_t lBlockSize = 256;
+    std::vector<float> lIR = randomSignal<float>(48000 * 2, 1);
+    fbu::UniformConvolverf lConvolver(std::make_shared<const fbu::ConvolutionIRf>(lIR.data(), lIR.size(), lBlockSize), 1);
+    std::vector<float> lBlock = randomSignal<float>(lBlockSize, 2);
+    const int lNumRuns = 1000;
+    StopWatch lSW;
+    lSW.start();
+    for (int r = 0 ; r != lNumRuns ; ++r)
+    {
+        lConvolver.processBlock(0, lBlock.data(), lBlock.data());
+    }
+    lSW.stop();
+    std::cout << "UniformConvolver 2 s IR, block " << lBlockSize << ": "
+              << 1e6 * lSW.getSeconds() / lNumRuns << " us per block" << std::endl;
+}
+
+CASE("NonUniformConvolver: matches direct convolution, with and without ThreadPool")
+{
+    const size_t lBlockSize = 16;
+    std::vector<float> lIR = randomSignal<float>(3000, 6);
+    std::vector<float> lSignals[2] = {randomSignal<float>(400 * lBlockSize, 7), randomSignal<float>(400 * lBlockSize, 8)};
+    std::vector<float> lExpected[2] = {directConvolution(lSignals[0], lIR), directConvolution(lSignals[1], lIR)};
+    fbu::ThreadPool lThreadPool(2);
+    for (int lUsePool = 0 ; lUsePool != 2 ; ++lUsePool)
+    {
+        fbu::NonUniformConvolverf lConvolver(lIR.data(), lIR.size(), lBlockSize, 2,
+                                             lUsePool ? &lThreadPool : nullptr, 1024);
+        // head [0, 128), then partitions of 64, 256 and 1024 up to the end
+        EXPECT(lConvolver.getNumStages() == 3u);
+        EXPECT(lConvolver.getStagePartitionSize(2) == 1024u);
+        std::vector<float> lOutputs[2] = {lSignals[0], lSignals[1]};
+        for (size_t b = 0 ; b != 400 ; ++b)
+        {
+            float* lBlocks[2] = {lOutputs[0].data() + b * lBlockSize, lOutputs[1].data() + b * lBlockSize};
+            // in place
+            lConvolver.processBlock(lBlocks, lBlocks);
+        }
+        for (int c = 0 ; c != 2 ; ++c)
+        {
+            float lMaxError = 0.f;
+            for (size_t n = 0 ; n != lExpected[c].size() ; ++n)
+            {
+                lMaxError = std::max(lMaxError, std::abs(lOutputs[c][n] - lExpected[c][n]));
+            }
+            EXPECT(lMaxError < 1e-3f);
+        }
+    }
+    lThreadPool.waitForCompletion();
+}
+
+CASE("NonUniformConvolver: benchmark" "[.bench]")
+{
+    const size_t lBlockSize = 64;
+    std::vector<float> lIR = randomSignal<float>(48000 * 4, 1);
+    fbu::ThreadPool lThreadPool(2);
+    fbu::NonUniformConvolverf lNonUniform(lIR.data(), lIR.size(), lBlockSize, 1, &lThreadPool);
+    fbu::UniformConvolverf lUniform(std::make_shared<const fbu::ConvolutionIRf>(lIR.data(), lIR.size(), lBlockSize), 1);
+    std::vector<float> lBlock = randomSignal<float>(lBlockSize, 2);
+    float* lBlocks[1] = {lBlock.data()};
+    const int lNumRuns = 3000;
+    StopWatch lSW;
+    lSW.start();
+    for (int r = 0 ; r != lNumRuns ; ++r)
+    {
+        lNonUniform.processBlock(lBlocks, lBlocks);
+    }
+    lSW.stop();
+    std::cout << "NonUniformConvolver 4 s IR, block " << lBlockSize << ": "
+              << 1e6 * lSW.getSeconds() / lNumRuns << " us per block (audio thread)" << std::endl;
+    lSW.start();
+    for (int r = 0 ; r != lNumRuns ; ++r)
+    {
+        lUniform.processBlock(0, lBlock.data(), lBlock.data());
+    }
+    lSW.stop();
+    std::cout << "UniformConvolver 4 s IR, block " << lBlockSize << ": "
+              << 1e6 * lSW.getSeconds() / lNumRuns << " us per block" << std::endl;
+    lThreadPool.waitForCompletion();
+}
@@ -0,0 +1,88 @@
+#include "fbu/cross_correlation.hpp"
+
+#include "tests_common.hpp"
+
+#include <vector>
+
+namespace
+{
+    // sum of sinusoids, which can be delayed by a fraction of a sample exactly
+    std::vector<float> multitone(size_t pSize, double pDelay)
+    {
+        std::vector<float> lSignal(pSize, 0.f);
+        for (int k = 1 ; k <= 40 ; ++k)
+        {
+            double lFrequency = 0.011 * k;
+            double lPhase = 0.7 * k * k;
+            for (size_t n = 0 ; n != pSize ; ++n)
+            {
+                lSignal[n] += (float)std::cos(2. * M_PI * lFrequency * ((double)n - pDelay) + lPhase);
+            }
+        }
+        return lSignal;
+    }
+}
+
+CASE("CrossCorrelator: integer delays, positive and negative")
+{
+    const size_t N = 512;
+    std::vector<float> x = randomSignal<float>(N + 100, 1);
+    for (int lDelay : {0, 7, -13, 60})
+    {
+        // y[n] = x[n - delay]
+        std::vector<float> y(N);
+        for (size_t n = 0 ; n != N ; ++n)
+        {
+            y[n] = x[(size_t)((long)n + 50 - lDelay)];
+        }
+        for (auto lWeighting : {fbu::CrossCorrelationWeighting::None, fbu::CrossCorrelationWeighting::PHAT})
+        {
+            fbu::CrossCorrelatorf lCorrelator(N, lWeighting);
+            auto lEstimate = lCorrelator.estimate(x.data() + 50, y.data(), 100);
+            EXPECT(std::abs(lEstimate.mLag - (float)lDelay) < 0.1f);
+        }
+    }
+    // the PHAT peak of a pure delay is close to 1 for a circular shift
+    fbu::CrossCorrelatorf lCorrelator(N);
+    std::vector<float> lCorrelation(lCorrelator.getCorrelationSize());
+    lCorrelator.correlate(x.data(), x.data(), lCorrelation.data());
+    EXPECT(lCorrelation[0] == lest::approx(1.f));
+}
+
+CASE("CrossCorrelator: sub-sample delay")
+{
+    const size_t N = 1024;
+    std::vector<float> x = multitone(N, 0.);
+    std::vector<float> y = multitone(N, 3.4);
+    fbu::CrossCorrelatorf lCorrelator(N, fbu::CrossCorrelationWeighting::None);
+    auto lEstimate = lCorrelator.estimate(x.data(), y.data(), 20);
+    EXPECT(std::abs(lEstimate.mLag - 3.4f) < 0.2f);
+}
+
+CASE("CrossCorrelator: streaming estimate from noisy blocks")
+{
+    const size_t N = 256;
+    const int lDelay = 21;
+    std::vector<float> x = randomSignal<float>(20 * N + lDelay, 2);
+    std::vector<float> lNoise = randomSignal<float>(20 * N, 3);
+    std::vector<float> y(20 * N);
+    for (size_t n = 0 ; n != y.size() ; ++n)
+    {
+        y[n] = x[n] + 1.5f * lNoise[n];
+    }
+    fbu::CrossCorrelatorf lCorrelator(N, fbu::CrossCorrelationWeighting::PHAT, 0.2f);
+    size_t lPosition = 0;
+    size_t lSizes[] = {100, 33, 256, 1};
+    for (size_t i = 0 ; lPosition != y.size() ; ++i)
+    {
+        size_t n = std::min(lSizes[i % 4], y.size() - lPosition);
+        lCorrelator.push(x.data() + lDelay + lPosition, y.data() + lPosition, n);
+        lPosition += n;
+    }
+    EXPECT(lCorrelator.getNumFrames() == 20);
+    // x[n + delay] is pushed with y[n]: y is late by delay
+    auto lEstimate = lCorrelator.getEstimate(50);
+    EXPECT(std::abs(lEstimate.mLag - (float)lDelay) < 0.5f);
+    lCorrelator.reset();
+    EXPECT(lCorrelator.getNumFrames() == 0);
+}
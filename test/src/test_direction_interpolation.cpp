@@ -0,0 +1,102 @@
+#include "fbu/direction_interpolation.hpp"
+
+#include "tests_common.hpp"
+
+CASE("Direction interpolation: slerp, nlerp and slerp steps")
+{
+    Vector3f lA[2] = {Vector3f::fromAE(AEf::ae(0.f)), Vector3f::fromAE(AEf::ae(0.2f, 0.1f))};
+    Vector3f lB[2] = {Vector3f::fromAE(AEf::ae(1.2f)), Vector3f::fromAE(AEf::ae(-1.f, 0.8f))};
+    Vector3f lSlerp[2];
+    vectSlerp(lA, lB, 0.25f, lSlerp, 2);
+    EXPECT(lSlerp[0].mX == lest::approx(std::cos(0.3f)));
+    EXPECT(lSlerp[0].mY == lest::approx(std::sin(0.3f)));
+    
+    Vector3f lNlerp[2];
+    vectNlerp(lA, lB, 0.5f, lNlerp, 2);
+    EXPECT(lNlerp[0].mX == lest::approx(std::cos(0.6f)));
+    EXPECT(lNlerp[1].length() == lest::approx(1.f));
+    
+    const int lNumSteps = 8;
+    Vector3f lSteps[lNumSteps * 2];
+    vectSlerpSteps(lA, lB, lNumSteps, lSteps, 2);
+    for (int s = 0 ; s != lNumSteps ; ++s)
+    {
+        Vector3f lExpected[2];
+        vectSlerp(lA, lB, (float)(s + 1) / (float)lNumSteps, lExpected, 2);
+        for (int u = 0 ; u != 2 ; ++u)
+        {
+            EXPECT(lSteps[s * 2 + u].dot(lExpected[u]) == lest::approx(1.f));
+        }
+    }
+}
+
+CASE("Direction interpolation: no step, antipodal directions stay on a great circle")
+{
+    Vector3f lA[1] = {Vector3f::cartesian(1.f, 0.f, 0.f)};
+    Vector3f lB[1] = {Vector3f::cartesian(-1.f, 0.f, 0.f)};
+    Vector3f lUntouched[1] = {Vector3f::cartesian(0.f, 0.f, 7.f)};
+    vectSlerpSteps(lA, lB, 0, lUntouched, 1);
+    vectSlerpSteps(lA, lB, -3, lUntouched, 1);
+    EXPECT(lUntouched[0].mZ == 7.f);
+
+    // exactly and nearly antipodal: unit length, constant angular speed
+    Vector3f lNearB[1] = {Vector3f::cartesian(-1.f, 0.f, 0.001f).normalizedWithDefault(lB[0])};
+    for (const Vector3f* lEnd : {lB, lNearB})
+    {
+        const int lNumSteps = 10;
+        Vector3f lSteps[lNumSteps];
+        vectSlerpSteps(lA, lEnd, lNumSteps, lSteps, 1);
+        Vector3f lPrevious = lA[0];
+        float lAngle = std::acos(mu::limitedRange(lA[0].dot(lEnd[0]), -1.f, 1.f));
+        for (int s = 0 ; s != lNumSteps ; ++s)
+        {
+            Vector3f lSlerp[1];
+            vectSlerp(lA, lEnd, (float)(s + 1) / (float)lNumSteps, lSlerp, 1);
+            EXPECT(lSlerp[0].length() == lest::approx(1.f));
+            EXPECT(lSlerp[0].dot(lSteps[s]) == lest::approx(1.f));
+            EXPECT(lSteps[s].dot(lPrevious) == lest::approx(std::cos(lAngle / (float)lNumSteps)).epsilon(1e-3));
+            lPrevious = lSteps[s];
+        }
+    }
+}
+
+CASE("DirectionSmoother: linear ramp reaches the target in the given sub-blocks")
+{
+    fbu::DirectionSmoother<float> lSmoother(3, fbu::DirectionSmoother<float>::Mode::LinearRamp, 4.f);
+    AEf lTargets[3] = {AEf::ae(1.f), AEf::ae(-1.f, 0.5f), AEf::ae(0.f)};
+    lSmoother.setTargets(lTargets);
+    std::vector<Vector3f> lOut(4 * 3);
+    lSmoother.process(4, lOut.data());
+    // monotonic approach, unit length
+    for (int s = 1 ; s != 4 ; ++s)
+    {
+        EXPECT(lOut[(size_t)s * 3].length() == lest::approx(1.f));
+        EXPECT(lOut[(size_t)s * 3].mY > lOut[(size_t)(s - 1) * 3].mY);
+    }
+    for (int u = 0 ; u != 3 ; ++u)
+    {
+        Vector3f lExpected = Vector3f::fromAE(lTargets[u]);
+        EXPECT(lSmoother.getDirections()[u].dot(lExpected) == lest::approx(1.f));
+    }
+}
+
+CASE("DirectionSmoother: one pole converges and survives antipodal targets")
+{
+    fbu::DirectionSmoother<float> lSmoother(1, fbu::DirectionSmoother<float>::Mode::OnePole, 2.f);
+    lSmoother.reset(0, Vector3f::cartesian(1.f, 0.f, 0.f));
+    lSmoother.setTarget(0, Vector3f::cartesian(0.f, 0.f, 3.f));
+    const Vector3f* lDirections = lSmoother.process();
+    EXPECT(lDirections[0].mZ > 0.f);
+    EXPECT(lDirections[0].mZ < 1.f);
+    for (int s = 0 ; s != 100 ; ++s)
+    {
+        lSmoother.process();
+    }
+    EXPECT(lDirections[0].mZ == lest::approx(1.f));
+    lSmoother.setTarget(0, Vector3f::cartesian(0.f, 0.f, -1.f));
+    for (int s = 0 ; s != 100 ; ++s)
+    {
+        lSmoother.process();
+        EXPECT(std::isfinite(lDirections[0].mZ));
+    }
+}
@@ -0,0 +1,144 @@
+#include "fbu/fft.hpp"
+#include "fbu/stopwatch.hpp"
+
+#include "tests_common.hpp"
+
+namespace
+{
+    std::vector<Complexd> naiveDFT(const std::vector<Complexd>& pIn)
+    {
+        size_t n = pIn.size();
+        std::vector<Complexd> lOut(n);
+        for (size_t k = 0 ; k != n ; ++k)
+        {
+            Complexd lSum = {0., 0.};
+            for (size_t t = 0 ; t != n ; ++t)
+            {
+                lSum += pIn[t] * Complexd::polar(1., - 2. * M_PI * (double)((k * t) % n) / (double)n);
+            }
+            lOut[k] = lSum;
+        }
+        return lOut;
+    }
+    
+}
+
+CASE("FFT: matches a naive DFT for radix-2 and radix-4 sizes")
+{
+    for (size_t lSize = 1 ; lSize <= 512 ; lSize *= 2)
+    {
+        std::vector<Complexd> lIn = randomComplexes<double>(lSize, (unsigned)lSize);
+        std::vector<Complexd> lExpected = naiveDFT(lIn);
+        std::vector<Complexd> lOut(lSize);
+        fbu::FFTd lFFT(lSize);
+        lFFT.forward(lIn.data(), lOut.data());
+        double lMaxError = 0.;
+        for (size_t k = 0 ; k != lSize ; ++k)
+        {
+            lMaxError = std::max(lMaxError, (lOut[k] - lExpected[k]).mag());
+        }
+        EXPECT(lMaxError < 1e-9);
+        
+        // in-place inverse goes back to the input
+        lFFT.inverse(lOut.data(), lOut.data());
+        lMaxError = 0.;
+        for (size_t k = 0 ; k != lSize ; ++k)
+        {
+            lMaxError = std::max(lMaxError, (lOut[k] - lIn[k]).mag());
+        }
+        EXPECT(lMaxError < 1e-12);
+    }
+}
+
+CASE("FFT: cached plans are shared")
+{
+    auto lPlan = fbu::FFTf::get(1024);
+    EXPECT(lPlan.get() == fbu::FFTf::get(1024).get());
+    EXPECT(lPlan.get() != fbu::FFTf::get(2048).get());
+    EXPECT(lPlan->getSize() == 1024u);
+    EXPECT(lPlan->getOrder() == 10);
+    std::vector<Complexf> lImpulse(1024, {0.f, 0.f});
+    lImpulse[0] = {1.f, 0.f};
+    lPlan->forward(lImpulse.data(), lImpulse.data());
+    for (const Complexf& c : lImpulse)
+    {
+        EXPECT(c.re == lest::approx(1.f));
+    }
+}
+
+CASE("RealFFT: matches the complex FFT and inverts")
+{
+    for (size_t lSize = 2 ; lSize <= 1024 ; lSize *= 2)
+    {
+        std::vector<Complexd> lComplexIn = randomComplexes<double>(lSize, (unsigned)lSize);
+        std::vector<double> lRealIn(lSize);
+        for (size_t n = 0 ; n != lSize ; ++n)
+        {
+            lRealIn[n] = lComplexIn[n].re;
+            lComplexIn[n].im = 0.;
+        }
+        std::vector<Complexd> lExpected(lSize);
+        fbu::FFTd(lSize).forward(lComplexIn.data(), lExpected.data());
+        
+        auto lPlan = fbu::RealFFTd::get(lSize);
+        EXPECT(lPlan->getNumBins() == lSize / 2 + 1);
+        std::vector<Complexd> lBins(lPlan->getNumBins());
+        lPlan->forward(lRealIn.data(), lBins.data());
+        double lMaxError = 0.;
+        for (size_t k = 0 ; k != lBins.size() ; ++k)
+        {
+            lMaxError = std::max(lMaxError, (lBins[k] - lExpected[k]).mag());
+        }
+        EXPECT(lMaxError < 1e-10);
+        
+        std::vector<double> lRealOut(lSize);
+        lPlan->inverse(lBins.data(), lRealOut.data());
+        lMaxError = 0.;
+        for (size_t n = 0 ; n != lSize ; ++n)
+        {
+            lMaxError = std::max(lMaxError, std::abs(lRealOut[n] - lRealIn[n]));
+        }
+        EXPECT(lMaxError < 1e-12);
+    }
+}
+
+CASE("FFT: benchmark" "[.bench]")
+{
+    for (size_t lSize = 64 ; lSize <= 65536 ; lSize *= 2)
+    {
+        auto lPlan = fbu::FFTf::get(lSize);
+        std::vector<Complexf> lData(lSize, {0.5f, 0.25f});
+        int lNumRuns = (int)(4 * 1048576 / lSize);
+        StopWatch lSW;
+        lSW.start();
+        for (int r = 0 ; r != lNumRuns ; ++r)
+        {
+            lPlan->forward(lData.data(), lData.data());
+            lPlan->inverse(lData.data(), lData.data());
+        }
+        lSW.stop();
+        double lNs = 1e9 * lSW.getSeconds() / (2. * lNumRuns);
+        std::cout << "FFT " << lSize << ": " << lNs << " ns, "
+                  << 5. * (double)lSize * lPlan->getOrder() / lNs << " GFlops" << std::endl;
+    }
+}
+
+CASE("RealFFT: benchmark" "[.bench]")
+{
+    for (size_t lSize = 64 ; lSize <= 65536 ; lSize *= 2)
+    {
+        auto lPlan = fbu::RealFFTf::get(lSize);
+        std::vector<float> lSignal(lSize, 0.5f);
+        std::vector<Complexf> lBins(lPlan->getNumBins());
+        int lNumRuns = (int)(4 * 1048576 / lSize);
+        StopWatch lSW;
+        lSW.start();
+        for (int r = 0 ; r != lNumRuns ; ++r)
+        {
+            lPlan->forward(lSignal.data(), lBins.data());
+            lPlan->inverse(lBins.data(), lSignal.data());
+        }
+        lSW.stop();
+        std::cout << "RealFFT " << lSize << ": " << 1e9 * lSW.getSeconds() / (2. * lNumRuns) << " ns" << std::endl;
+    }
+}
@@ -0,0 +1,121 @@
+#include "fbu/fft_batch.hpp"
+#include "fbu/stopwatch.hpp"
+
+#include "tests_common.hpp"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    std::vector< std::vector<Complexf> > randomChannels(int pNumChannels, size_t pSize)
+    {
+        std::mt19937 lRandomGenerator((unsigned)pSize);
+        std::uniform_real_distribution<float> lDistribution(-1.f, 1.f);
+        std::vector< std::vector<Complexf> > lChannels((size_t)pNumChannels, std::vector<Complexf>(pSize));
+        for (auto& lChannel : lChannels)
+        {
+            for (Complexf& c : lChannel)
+            {
+                c = {lDistribution(lRandomGenerator), lDistribution(lRandomGenerator)};
+            }
+        }
+        return lChannels;
+    }
+    
+    std::vector<Complexf*> pointers(std::vector< std::vector<Complexf> >& pChannels)
+    {
+        std::vector<Complexf*> lPointers;
+        for (auto& lChannel : pChannels)
+        {
+            lPointers.push_back(lChannel.data());
+        }
+        return lPointers;
+    }
+}
+
+CASE("BatchFFT: matches FFT on every channel, with and without ThreadPool")
+{
+    fbu::ThreadPool lThreadPool(3);
+    const int lNumChannels = 19;
+    for (size_t lSize : {1u, 2u, 64u, 128u, 2048u})
+    {
+        for (int lUsePool = 0 ; lUsePool != 2 ; ++lUsePool)
+        {
+            fbu::BatchFFTf lBatch(lSize, lNumChannels, lUsePool ? &lThreadPool : nullptr);
+            auto lChannels = randomChannels(lNumChannels, lSize);
+            auto lData = lChannels;
+            auto lPointers = pointers(lData);
+            // in place
+            lBatch.forward(lPointers.data(), lPointers.data());
+            auto lPlan = fbu::FFTf::get(lSize);
+            float lMaxError = 0.f;
+            for (size_t c = 0 ; c != lChannels.size() ; ++c)
+            {
+                std::vector<Complexf> lExpected(lSize);
+                lPlan->forward(lChannels[c].data(), lExpected.data());
+                for (size_t k = 0 ; k != lSize ; ++k)
+                {
+                    lMaxError = std::max(lMaxError, (lData[c][k] - lExpected[k]).mag());
+                }
+            }
+            EXPECT(lMaxError < 1e-3f);
+            
+            lBatch.inverse(lPointers.data(), lPointers.data());
+            lMaxError = 0.f;
+            for (size_t c = 0 ; c != lChannels.size() ; ++c)
+            {
+                for (size_t k = 0 ; k != lSize ; ++k)
+                {
+                    lMaxError = std::max(lMaxError, (lData[c][k] - lChannels[c][k]).mag());
+                }
+            }
+            EXPECT(lMaxError < 1e-5f);
+        }
+    }
+    lThreadPool.waitForCompletion();
+}
+
+CASE("BatchFFT: benchmark" "[.bench]")
+{
+    fbu::ThreadPool lThreadPool(4);
+    const int lNumChannels = 64;
+    for (size_t lSize : {64u, 256u, 1024u, 4096u})
+    {
+        auto lChannels = randomChannels(lNumChannels, lSize);
+        auto lPointers = pointers(lChannels);
+        auto lPlan = fbu::FFTf::get(lSize);
+        fbu::BatchFFTf lBatch(lSize, lNumChannels);
+        fbu::BatchFFTf lPooledBatch(lSize, lNumChannels, &lThreadPool);
+        const int lNumRuns = (int)(1048576 / lSize);
+        StopWatch lSW;
+        lSW.start();
+        for (int r = 0 ; r != lNumRuns ; ++r)
+        {
+            for (Complexf* p : lPointers)
+            {
+                lPlan->forward(p, p);
+            }
+        }
+        lSW.stop();
+        double lLoop = 1e6 * lSW.getSeconds() / lNumRuns;
+        lSW.start();
+        for (int r = 0 ; r != lNumRuns ; ++r)
+        {
+            lBatch.forward(lPointers.data(), lPointers.data());
+        }
+        lSW.stop();
+        double lBatched = 1e6 * lSW.getSeconds() / lNumRuns;
+        lSW.start();
+        for (int r = 0 ; r != lNumRuns ; ++r)
+        {
+            lPooledBatch.forward(lPointers.data(), lPointers.data());
+        }
+        lSW.stop();
+        double lPooled = 1e6 * lSW.getSeconds() / lNumRuns;
+        std::cout << "64 channels, FFT " << lSize << ": loop " << lLoop << " us, batch " << lBatched
+                  << " us, batch on ThreadPool " << lPooled << " us" << std::endl;
+    }
+    lThreadPool.waitForCompletion();
+}
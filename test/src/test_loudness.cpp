@@ -0,0 +1,85 @@
+#include "fbu/loudness.hpp"
+
+#include "tests_common.hpp"
+
+#include <vector>
+
+namespace
+{
+    /**
+     Feed pSeconds of a 997 Hz sine at pLevelDB dBFS to all the channels.
+     */
+    template <typename T>
+    void feedSine(fbu::LoudnessMeter<T>& pMeter, double pLevelDB, double pSeconds, double& pPhase)
+    {
+        const int kBlockSize = 1000;
+        const double lAmplitude = std::pow(10., pLevelDB / 20.);
+        const double lIncrement = 2. * M_PI * 997. / pMeter.getSampleRate();
+        std::vector<T> lBuffer(kBlockSize);
+        std::vector<const T*> lChannels((size_t)pMeter.getNumChannels(), lBuffer.data());
+        int lNumBlocks = (int)std::lround(pSeconds * pMeter.getSampleRate() / kBlockSize);
+        for (int b = 0 ; b != lNumBlocks ; ++b)
+        {
+            for (T& x : lBuffer)
+            {
+                x = (T)(lAmplitude * std::sin(pPhase));
+                pPhase += lIncrement;
+            }
+            pMeter.process(lChannels.data(), kBlockSize);
+        }
+    }
+}
+
+CASE("LoudnessMeter: a full scale 997 Hz sine reads -3.01 LUFS, at any sample rate")
+{
+    const double lSampleRates[] = {44100., 48000., 96000.};
+    for (double lSampleRate : lSampleRates)
+    {
+        fbu::LoudnessMeter<double> lMeter(1, lSampleRate);
+        double lPhase = 0.;
+        feedSine(lMeter, 0., 4., lPhase);
+        EXPECT(lMeter.getMomentaryLoudness() == lest::approx(-3.01).epsilon(0.005));
+        EXPECT(lMeter.getShortTermLoudness() == lest::approx(-3.01).epsilon(0.005));
+        EXPECT(lMeter.getIntegratedLoudness() == lest::approx(-3.01).epsilon(0.005));
+    }
+}
+
+CASE("LoudnessMeter: float, stereo and channel weights")
+{
+    // EBU Tech 3341 case 1: stereo -23 dBFS sine reads -23 LUFS
+    fbu::LoudnessMeterf lMeter(2, 48000.);
+    double lPhase = 0.;
+    feedSine(lMeter, -23., 20., lPhase);
+    EXPECT(lMeter.getIntegratedLoudness() == lest::approx(-23.).epsilon(0.005));
+    // a surround weight adds 1.5 dB on its channel
+    fbu::LoudnessMeterf lSurround(1, 48000.);
+    lSurround.setChannelWeight(0, fbu::LoudnessMeterf::kSurroundWeight);
+    lPhase = 0.;
+    feedSine(lSurround, -20., 1., lPhase);
+    EXPECT(lSurround.getMomentaryLoudness() == lest::approx(-23.01 + 1.49).epsilon(0.005));
+    lSurround.setChannelWeight(0, 0.f);
+    feedSine(lSurround, -20., 1., lPhase);
+    EXPECT(lSurround.getMomentaryLoudness() == -144.);
+}
+
+CASE("LoudnessMeter: gated integration and loudness range")
+{
+    fbu::LoudnessMeter<double> lMeter(2, 48000.);
+    EXPECT(lMeter.getIntegratedLoudness() == -144.);
+    EXPECT(lMeter.getLoudnessRange() == 0.);
+    double lPhase = 0.;
+    // EBU Tech 3341 case 3 (the -36 dB part is under the relative gate)
+    feedSine(lMeter, -36., 10., lPhase);
+    feedSine(lMeter, -23., 60., lPhase);
+    feedSine(lMeter, -36., 10., lPhase);
+    EXPECT(lMeter.getIntegratedLoudness() == lest::approx(-23.).epsilon(0.005));
+    // silence is under the absolute gate
+    feedSine(lMeter, -200., 20., lPhase);
+    EXPECT(lMeter.getIntegratedLoudness() == lest::approx(-23.).epsilon(0.005));
+
+    // EBU Tech 3342 case 1
+    lMeter.reset();
+    feedSine(lMeter, -20., 20., lPhase);
+    feedSine(lMeter, -30., 20., lPhase);
+    EXPECT(lMeter.getLoudnessRange() == lest::approx(10.).epsilon(0.1));
+}
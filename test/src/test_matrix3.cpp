@@ -0,0 +1,70 @@
+#include "fbu/matrix3.hpp"
+
+#include "tests_common.hpp"
+
+CASE("Matrix3: yaw/pitch/roll rotates the front vector like AE")
+{
+    Matrix3f lM = Matrix3f::fromYawPitchRoll(0.7f, 0.3f, -1.1f);
+    Vector3f lFront = lM.rotate(Vector3f::cartesian(1.f, 0.f, 0.f));
+    Vector3f lExpected = Vector3f::fromAE(AEf::ae(0.7f, 0.3f));
+    EXPECT(lFront.mX == lest::approx(lExpected.mX));
+    EXPECT(lFront.mY == lest::approx(lExpected.mY));
+    EXPECT(lFront.mZ == lest::approx(lExpected.mZ));
+}
+
+CASE("Matrix3: yaw/pitch/roll round trip")
+{
+    Matrix3f lM = Matrix3f::fromYawPitchRoll(-2.5f, 0.4f, 1.3f);
+    float lYaw, lPitch, lRoll;
+    lM.toYawPitchRoll(lYaw, lPitch, lRoll);
+    EXPECT(lYaw == lest::approx(-2.5f).epsilon(0.0001));
+    EXPECT(lPitch == lest::approx(0.4f).epsilon(0.0001));
+    EXPECT(lRoll == lest::approx(1.3f).epsilon(0.0001));
+}
+
+CASE("Matrix3: inverse")
+{
+    Matrix3f lM = {{{2.f, 0.f, 1.f}, {1.f, 3.f, 0.f}, {0.f, 1.f, 4.f}}};
+    Matrix3f lInv;
+    EXPECT(lM.inverse(lInv));
+    Matrix3f lId = lM * lInv;
+    for (int i = 0 ; i != 3 ; ++i)
+    {
+        for (int j = 0 ; j != 3 ; ++j)
+        {
+            EXPECT(lId.m[i][j] + 1.f == lest::approx(i == j ? 2.f : 1.f));
+        }
+    }
+    Matrix3f lSingular = {{{1.f, 2.f, 3.f}, {2.f, 4.f, 6.f}, {0.f, 1.f, 4.f}}};
+    EXPECT_NOT(lSingular.inverse(lInv));
+}
+
+CASE("Matrix3: batch rotation matches scalar rotation")
+{
+    Matrix3f lM = Matrix3f::fromYawPitchRoll(1.f, -0.2f, 0.5f);
+    Vector3f lIn[5];
+    float lX[5], lY[5], lZ[5];
+    for (int i = 0 ; i != 5 ; ++i)
+    {
+        lIn[i] = Vector3f::cartesian((float)i, 1.f - (float)i, 0.5f * (float)i);
+        lX[i] = lIn[i].mX;
+        lY[i] = lIn[i].mY;
+        lZ[i] = lIn[i].mZ;
+    }
+    Vector3f lOut[5];
+    vectRotate(lM, lIn, lOut, 5);
+    float lOX[5], lOY[5], lOZ[5];
+    vectRotateSoA(lM, lX, lY, lZ, lOX, lOY, lOZ, 5);
+    vectRotate_I(lM, lIn, 5);
+    for (int i = 0 ; i != 5 ; ++i)
+    {
+        Vector3f lExpected = lM * Vector3f::cartesian((float)i, 1.f - (float)i, 0.5f * (float)i);
+        EXPECT(lOut[i].mX == lest::approx(lExpected.mX));
+        EXPECT(lOut[i].mY == lest::approx(lExpected.mY));
+        EXPECT(lOut[i].mZ == lest::approx(lExpected.mZ));
+        EXPECT(lIn[i].mX == lest::approx(lExpected.mX));
+        EXPECT(lOX[i] == lest::approx(lExpected.mX));
+        EXPECT(lOY[i] == lest::approx(lExpected.mY));
+        EXPECT(lOZ[i] == lest::approx(lExpected.mZ));
+    }
+}
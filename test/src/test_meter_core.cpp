@@ -0,0 +1,339 @@
+#include "fbu/meter_core.hpp"
+
+#include "tests_common.hpp"
+
+#include "fbu/stopwatch.hpp"
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+CASE("vectPeakAndSumOfSquares: matches the scalar loop, any size")
+{
+    std::vector<float> x(37);
+    for (size_t u = 0 ; u != x.size() ; ++u)
+    {
+        x[u] = std::sin(0.37f * (float)u) * (float)(u % 5);
+    }
+    x[35] = -7.f;
+    for (size_t lSize = 0 ; lSize <= x.size() ; ++lSize)
+    {
+        float lPeak = 0.f;
+        float lSum = 0.f;
+        for (size_t u = 0 ; u != lSize ; ++u)
+        {
+            lPeak = std::max(lPeak, std::abs(x[u]));
+            lSum += x[u] * x[u];
+        }
+        float lVectPeak;
+        float lVectSum;
+        vectPeakAndSumOfSquares(x.data(), lSize, lVectPeak, lVectSum);
+        EXPECT(lVectPeak == lPeak);
+        EXPECT(lVectSum == lest::approx(lSum).epsilon(1e-5));
+    }
+}
+
+CASE("atomicMax: concurrent updates keep the largest value")
+{
+    std::atomic<float> lMax(0.f);
+    std::vector<std::thread> lThreads;
+    for (int t = 0 ; t != 4 ; ++t)
+    {
+        lThreads.push_back(std::thread([&lMax, t]()
+        {
+            for (int i = 0 ; i != 10000 ; ++i)
+            {
+                fbu::atomicMax(lMax, (float)(i * 4 + t));
+            }
+        }));
+    }
+    for (std::thread& lThread : lThreads)
+    {
+        lThread.join();
+    }
+    EXPECT(lMax.load() == 39999.f);
+    fbu::atomicMax(lMax, 1.f);
+    EXPECT(lMax.load() == 39999.f);
+}
+
+CASE("MeterCore: peaks are held until read, RMS converges")
+{
+    const int kBlockSize = 64;
+    fbu::MeterCore lMeter(2, 48000., 0.01);
+    EXPECT(lMeter.getNumChannels() == 2);
+    std::vector<float> lLeft(kBlockSize);
+    std::vector<float> lRight(kBlockSize, 0.f);
+    const float* lChannels[] = {lLeft.data(), lRight.data()};
+    fbu::MeterCore::ChannelSnapshot lSnapshot[2];
+
+    // one loud block followed by quieter ones: the peak survives
+    std::fill(lLeft.begin(), lLeft.end(), 0.f);
+    lLeft[10] = -0.9f;
+    lMeter.process(lChannels, kBlockSize);
+    lLeft[10] = 0.1f;
+    lMeter.process(lChannels, kBlockSize);
+    lMeter.getSnapshot(lSnapshot, 2, false);
+    EXPECT(lSnapshot[0].mPeak == 0.9f);
+    lMeter.getSnapshot(lSnapshot, 2);
+    EXPECT(lSnapshot[0].mPeak == 0.9f);
+    EXPECT(lSnapshot[1].mPeak == 0.f);
+    lMeter.getSnapshot(lSnapshot, 2);
+    EXPECT(lSnapshot[0].mPeak == 0.f);
+
+    // full scale sine: RMS of 1/sqrt(2) after many time constants
+    for (int b = 0 ; b != 200 ; ++b)
+    {
+        for (int i = 0 ; i != kBlockSize ; ++i)
+        {
+            lLeft[(size_t)i] = std::sin(2.f * (float)M_PI * (float)(b * kBlockSize + i) / 32.f);
+        }
+        lMeter.process(lChannels, kBlockSize);
+    }
+    lMeter.getSnapshot(lSnapshot, 2);
+    EXPECT(lSnapshot[0].mRMS == lest::approx(std::sqrt(0.5f)).epsilon(1e-3));
+    EXPECT(lSnapshot[0].mPeak == lest::approx(1.f).epsilon(1e-5));
+    EXPECT(lSnapshot[1].mRMS == 0.f);
+    EXPECT(fbu::MeterCore::toDB(lSnapshot[0].mRMS) == lest::approx(-3.0103f).epsilon(1e-3));
+    EXPECT(fbu::MeterCore::toDB(0.f) == -144.f);
+
+    lMeter.reset();
+    lMeter.getSnapshot(lSnapshot, 2);
+    EXPECT(lSnapshot[0].mRMS == 0.f);
+}
+
+CASE("MeterCore: no peak is lost to a concurrent reader")
+{
+    const int kNumBlocks = 20000;
+    fbu::MeterCore lMeter(1, 48000.);
+    std::atomic<bool> lDone(false);
+    float lMaxRead = 0.f;
+    std::thread lReader([&]()
+    {
+        fbu::MeterCore::ChannelSnapshot lSnapshot;
+        while (!lDone.load())
+        {
+            lMeter.getSnapshot(&lSnapshot, 1);
+            lMaxRead = std::max(lMaxRead, lSnapshot.mPeak);
+        }
+        lMeter.getSnapshot(&lSnapshot, 1);
+        lMaxRead = std::max(lMaxRead, lSnapshot.mPeak);
+    });
+    float lSample = 0.f;
+    const float* lChannels[] = {&lSample};
+    for (int b = 0 ; b != kNumBlocks ; ++b)
+    {
+        lSample = (float)b / (float)kNumBlocks;
+        lMeter.process(lChannels, 1);
+    }
+    lSample = 2.f;
+    lMeter.process(lChannels, 1);
+    lDone.store(true);
+    lReader.join();
+    EXPECT(lMaxRead == 2.f);
+}
+
+namespace
+{
+    /**
+     Process pSeconds of a constant signal in 1 ms blocks.
+     */
+    void feedConstant(fbu::MeterCore& pMeter, float pValue, double pSeconds)
+    {
+        const int kBlockSize = (int)(pMeter.getSampleRate() / 1000.);
+        std::vector<float> lBuffer((size_t)kBlockSize, pValue);
+        std::vector<const float*> lChannels((size_t)pMeter.getNumChannels(), lBuffer.data());
+        for (int b = 0 ; b != (int)std::lround(pSeconds * 1000.) ; ++b)
+        {
+            pMeter.process(lChannels.data(), kBlockSize);
+        }
+    }
+}
+
+CASE("MeterCore: digital ballistics, peak-hold and frames")
+{
+    fbu::MeterCore lMeter(2, 48000., 0.3, fbu::MeterBallistics::digital());
+    EXPECT(!lMeter.updateFrame());
+    EXPECT(lMeter.getFrame().mChannels.size() == 2u);
+    EXPECT(lMeter.getFrame().mChannels[0].mLevelDB == -144.f);
+
+    feedConstant(lMeter, 1.f, 0.01);
+    EXPECT(lMeter.updateFrame());
+    EXPECT(lMeter.getFrame().mBlockIndex == 10u);
+    EXPECT(lMeter.getFrame().mChannels[1].mLevelDB == lest::approx(0.f));
+    EXPECT(!lMeter.updateFrame());
+
+    // falls 20 dB in 1.7 s, while the marker holds for 2 s
+    feedConstant(lMeter, 0.f, 1.7);
+    lMeter.updateFrame();
+    EXPECT(lMeter.getFrame().mChannels[0].mLevelDB == lest::approx(-20.f).epsilon(1e-3));
+    EXPECT(lMeter.getFrame().mChannels[0].mHoldDB == lest::approx(0.f));
+    feedConstant(lMeter, 0.f, 0.31);
+    lMeter.updateFrame();
+    EXPECT(lMeter.getFrame().mChannels[0].mHoldDB == lMeter.getFrame().mChannels[0].mLevelDB);
+    EXPECT(lMeter.getFrame().mChannels[0].mLevelDB < -23.f);
+}
+
+CASE("MeterCore: PPM and VU ballistics")
+{
+    // a 10 ms burst reads -2 dB on a Type II PPM
+    fbu::MeterCore lPPM(1, 48000., 0.3, fbu::MeterBallistics::ppmType2());
+    feedConstant(lPPM, 1.f, 0.01);
+    lPPM.updateFrame();
+    EXPECT(lPPM.getFrame().mChannels[0].mLevelDB == lest::approx(-2.f).epsilon(0.01));
+    lPPM.setBallistics(fbu::MeterBallistics::ppmType1());
+    lPPM.reset();
+    feedConstant(lPPM, 1.f, 0.01);
+    lPPM.updateFrame();
+    EXPECT(lPPM.getFrame().mChannels[0].mLevelDB == lest::approx(-1.f).epsilon(0.01));
+
+    // a VU reaches 99% of a step in 300 ms, and falls back as slowly
+    fbu::MeterCore lVU(1, 48000., 0.3, fbu::MeterBallistics::vu());
+    feedConstant(lVU, 0.5f, 0.3);
+    lVU.updateFrame();
+    EXPECT(lVU.getFrame().mChannels[0].mLevelDB == lest::approx(fbu::MeterCore::toDB(0.495f)).epsilon(0.01));
+    EXPECT(lVU.getFrame().mChannels[0].mHoldDB == lVU.getFrame().mChannels[0].mLevelDB);
+    feedConstant(lVU, 0.f, 0.3);
+    lVU.updateFrame();
+    EXPECT(lVU.getFrame().mChannels[0].mLevelDB == lest::approx(fbu::MeterCore::toDB(0.005f)).epsilon(0.01));
+}
+
+CASE("MeterCore: interleaved and planar blocks give the same values")
+{
+    for (int lNumChannels : {1, 3, 4, 21, 64})
+    {
+        const int kNumFrames = 77;
+        std::vector<float> lInterleaved((size_t)(lNumChannels * kNumFrames));
+        std::vector< std::vector<float> > lPlanar((size_t)lNumChannels, std::vector<float>(kNumFrames));
+        std::vector<const float*> lChannels;
+        for (int c = 0 ; c != lNumChannels ; ++c)
+        {
+            for (int f = 0 ; f != kNumFrames ; ++f)
+            {
+                float x = std::sin(0.1f * (float)(f * (c + 1))) * (float)(c + 1) / (float)lNumChannels;
+                lInterleaved[(size_t)(f * lNumChannels + c)] = x;
+                lPlanar[(size_t)c][(size_t)f] = x;
+            }
+            lChannels.push_back(lPlanar[(size_t)c].data());
+        }
+        fbu::MeterCore lPlanarMeter(lNumChannels, 48000., 0.3, fbu::MeterBallistics::ppmType2());
+        fbu::MeterCore lInterleavedMeter(lNumChannels, 48000., 0.3, fbu::MeterBallistics::ppmType2());
+        for (int b = 0 ; b != 3 ; ++b)
+        {
+            lPlanarMeter.process(lChannels.data(), kNumFrames);
+            lInterleavedMeter.processInterleaved(lInterleaved.data(), kNumFrames);
+        }
+        std::vector<fbu::MeterCore::ChannelSnapshot> lPlanarSnapshot((size_t)lNumChannels);
+        std::vector<fbu::MeterCore::ChannelSnapshot> lInterleavedSnapshot((size_t)lNumChannels);
+        lPlanarMeter.getSnapshot(lPlanarSnapshot.data(), lNumChannels);
+        lInterleavedMeter.getSnapshot(lInterleavedSnapshot.data(), lNumChannels);
+        lPlanarMeter.updateFrame();
+        lInterleavedMeter.updateFrame();
+        for (size_t c = 0 ; c != (size_t)lNumChannels ; ++c)
+        {
+            EXPECT(lInterleavedSnapshot[c].mPeak == lPlanarSnapshot[c].mPeak);
+            EXPECT(lInterleavedSnapshot[c].mRMS == lest::approx(lPlanarSnapshot[c].mRMS).epsilon(1e-5));
+            EXPECT(lInterleavedMeter.getFrame().mChannels[c].mLevelDB
+                   == lest::approx(lPlanarMeter.getFrame().mChannels[c].mLevelDB).epsilon(1e-5));
+        }
+    }
+}
+
+CASE("MeterCore: interleaved benchmark" "[.bench]")
+{
+    const int kNumChannels = 64;
+    const int kNumFrames = 512;
+    const int kNumBlocks = 2000;
+    std::vector<float> lInterleaved((size_t)(kNumChannels * kNumFrames));
+    for (size_t u = 0 ; u != lInterleaved.size() ; ++u)
+    {
+        lInterleaved[u] = std::sin(0.001f * (float)u);
+    }
+    std::vector<float> lPlanar(lInterleaved.size());
+    std::vector<const float*> lChannels;
+    for (int c = 0 ; c != kNumChannels ; ++c)
+    {
+        lChannels.push_back(lPlanar.data() + c * kNumFrames);
+    }
+    fbu::MeterCore lMeter(kNumChannels, 48000.);
+    StopWatch lSW;
+    lSW.start();
+    for (int b = 0 ; b != kNumBlocks ; ++b)
+    {
+        for (int c = 0 ; c != kNumChannels ; ++c)
+        {
+            for (int f = 0 ; f != kNumFrames ; ++f)
+            {
+                lPlanar[(size_t)(c * kNumFrames + f)] = lInterleaved[(size_t)(f * kNumChannels + c)];
+            }
+        }
+        lMeter.process(lChannels.data(), kNumFrames);
+    }
+    lSW.stop();
+    double lDeinterleaved = 1e6 * lSW.getSeconds() / kNumBlocks;
+    lSW.start();
+    for (int b = 0 ; b != kNumBlocks ; ++b)
+    {
+        lMeter.processInterleaved(lInterleaved.data(), kNumFrames);
+    }
+    lSW.stop();
+    double lSinglePass = 1e6 * lSW.getSeconds() / kNumBlocks;
+    std::cout << "64 channels x 512 frames: de-interleave + planar " << lDeinterleaved
+              << " us, single interleaved pass " << lSinglePass << " us" << std::endl;
+}
+
+CASE("MeterCore: stereo correlation, balance and mid/side energies")
+{
+    const int kBlockSize = 480;
+    // pairs: identical, opposite, uncorrelated with the right channel louder
+    std::vector<fbu::MeterCore::StereoPair> lPairs = {{0, 1}, {0, 2}, {3, 4}};
+    fbu::MeterCore lPlanar(5, 48000., 0.05, fbu::MeterBallistics::digital(), lPairs);
+    fbu::MeterCore lInterleaved(5, 48000., 0.05, fbu::MeterBallistics::digital(), lPairs);
+    EXPECT(lPlanar.getNumStereoPairs() == 3);
+    std::vector< std::vector<float> > lChannels(5, std::vector<float>(kBlockSize));
+    std::vector<float> lInterleavedBlock(5 * kBlockSize);
+    std::vector<const float*> lPointers;
+    for (auto& lChannel : lChannels)
+    {
+        lPointers.push_back(lChannel.data());
+    }
+    size_t lPosition = 0;
+    for (int b = 0 ; b != 100 ; ++b)
+    {
+        for (size_t i = 0 ; i != kBlockSize ; ++i, ++lPosition)
+        {
+            float lSine = std::sin(2.f * (float)M_PI * (float)lPosition / 96.f);
+            float lCosine = std::cos(2.f * (float)M_PI * (float)lPosition / 96.f);
+            lChannels[0][i] = 0.5f * lSine;
+            lChannels[1][i] = 0.5f * lSine;
+            lChannels[2][i] = -0.5f * lSine;
+            lChannels[3][i] = 0.5f * lSine;
+            lChannels[4][i] = lCosine;
+            for (size_t c = 0 ; c != 5 ; ++c)
+            {
+                lInterleavedBlock[i * 5 + c] = lChannels[c][i];
+            }
+        }
+        lPlanar.process(lPointers.data(), kBlockSize);
+        lInterleaved.processInterleaved(lInterleavedBlock.data(), kBlockSize);
+    }
+    lPlanar.updateFrame();
+    lInterleaved.updateFrame();
+    for (const fbu::MeterCore* lMeter : {&lPlanar, &lInterleaved})
+    {
+        const std::vector<fbu::MeterCore::PairFrame>& lFrames = lMeter->getFrame().mPairs;
+        EXPECT(lFrames.size() == 3u);
+        // identical: all in the mid, 0.5 amplitude sine on both -> mid RMS 0.5
+        EXPECT(lFrames[0].mCorrelation == lest::approx(1.f).epsilon(1e-3));
+        EXPECT(std::abs(lFrames[0].mBalance) < 1e-3f);
+        EXPECT(lFrames[0].mMidDB == lest::approx(fbu::MeterCore::toDB(0.5f)).epsilon(1e-3));
+        EXPECT(lFrames[0].mSideDB < -60.f);
+        // opposite: all in the side
+        EXPECT(lFrames[1].mCorrelation == lest::approx(-1.f).epsilon(1e-3));
+        EXPECT(lFrames[1].mMidDB < -60.f);
+        EXPECT(lFrames[1].mSideDB == lest::approx(fbu::MeterCore::toDB(0.5f)).epsilon(1e-3));
+        // quadrature: uncorrelated, energies 1/8 and 1/2
+        EXPECT(std::abs(lFrames[2].mCorrelation) < 1e-3f);
+        EXPECT(lFrames[2].mBalance == lest::approx(0.6f).epsilon(1e-3));
+        EXPECT(lFrames[2].mMidDB == lest::approx(lFrames[2].mSideDB).epsilon(1e-3));
+    }
+}
@@ -0,0 +1,62 @@
+#include "fbu/quaternion.hpp"
+
+#include "tests_common.hpp"
+
+namespace
+{
+    bool approxEqual(const Vector3f& pA, const Vector3f& pB)
+    {
+        return std::abs(pA.mX - pB.mX) < 0.0001f
+            && std::abs(pA.mY - pB.mY) < 0.0001f
+            && std::abs(pA.mZ - pB.mZ) < 0.0001f;
+    }
+}
+
+CASE("Quaternion: yaw/pitch/roll agrees with Matrix3")
+{
+    Quaternionf lQ = Quaternionf::fromYawPitchRoll(0.9f, -0.6f, 2.f);
+    Matrix3f lM = Matrix3f::fromYawPitchRoll(0.9f, -0.6f, 2.f);
+    Vector3f lV = Vector3f::cartesian(0.3f, -1.2f, 0.7f);
+    EXPECT(approxEqual(lQ.rotate(lV), lM.rotate(lV)));
+    EXPECT(approxEqual(lQ.toMatrix3().rotate(lV), lM.rotate(lV)));
+    EXPECT(approxEqual(Quaternionf::fromMatrix3(lM).rotate(lV), lM.rotate(lV)));
+    float lYaw, lPitch, lRoll;
+    lQ.toYawPitchRoll(lYaw, lPitch, lRoll);
+    EXPECT(lYaw == lest::approx(0.9f).epsilon(0.0001));
+    EXPECT(lPitch == lest::approx(-0.6f).epsilon(0.0001));
+    EXPECT(lRoll == lest::approx(2.f).epsilon(0.0001));
+}
+
+CASE("Quaternion: composition and inverse")
+{
+    Quaternionf lA = Quaternionf::fromAxisAngle(Vector3f::cartesian(0.f, 0.f, 1.f), 0.5f);
+    Quaternionf lB = Quaternionf::fromAxisAngle(Vector3f::cartesian(1.f, 0.f, 0.f), -1.f);
+    Vector3f lV = Vector3f::cartesian(1.f, 2.f, 3.f);
+    EXPECT(approxEqual((lA * lB).rotate(lV), lA.rotate(lB.rotate(lV))));
+    EXPECT(approxEqual(lA.conj().rotate(lA.rotate(lV)), lV));
+    EXPECT(approxEqual(Quaternionf::identity() * lV, lV));
+}
+
+CASE("Quaternion: slerp")
+{
+    Vector3f lZ = Vector3f::cartesian(0.f, 0.f, 1.f);
+    Quaternionf lA = Quaternionf::identity();
+    Quaternionf lB = Quaternionf::fromAxisAngle(lZ, 1.2f);
+    Quaternionf lMid = Quaternionf::slerp(lA, lB, 0.5f);
+    EXPECT(approxEqual(lMid.rotate(Vector3f::cartesian(1.f, 0.f, 0.f)),
+                       Vector3f::fromAE(AEf::ae(0.6f))));
+    EXPECT(approxEqual(Quaternionf::slerp(lA, lB, 1.f).rotate(lZ), lZ));
+    EXPECT(Quaternionf::slerp(lA, lB, 0.3f).norm() == lest::approx(1.f));
+}
+
+CASE("Quaternion: batch rotation")
+{
+    Quaternionf lQ = Quaternionf::fromYawPitchRoll(-0.3f, 0.2f, 0.1f);
+    Vector3f lIn[3] = {{1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}, {0.f, 0.f, 1.f}};
+    Vector3f lOut[3];
+    vectRotate(lQ, lIn, lOut, 3);
+    for (int i = 0 ; i != 3 ; ++i)
+    {
+        EXPECT(approxEqual(lOut[i], lQ.rotate(lIn[i])));
+    }
+}
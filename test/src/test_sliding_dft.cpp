@@ -0,0 +1,74 @@
+#include "fbu/sliding_dft.hpp"
+
+#include "tests_common.hpp"
+
+#include <vector>
+
+CASE("SlidingDFT: matches the direct sum over the last N samples")
+{
+    const size_t N = 100;
+    const double lFrequencies[] = {0., 0.05, 0.1234, 0.25, 0.4999};
+    std::vector<double> x = randomSignal<double>(537, 1);
+    fbu::SlidingDFT<double> lSDFT(N, lFrequencies, 5);
+    EXPECT(lSDFT.getNumFrequencies() == 5u);
+    // odd chunks
+    lSDFT.process(x.data(), 200);
+    lSDFT.process(x.data() + 200, 337);
+    const size_t n = x.size() - 1;
+    for (size_t k = 0 ; k != 5 ; ++k)
+    {
+        Complexd lExpected = {0., 0.};
+        for (size_t j = 0 ; j != N ; ++j)
+        {
+            lExpected += x[n - j] * Complexd::polar(1., 2. * M_PI * lFrequencies[k] * (double)j);
+        }
+        EXPECT((lSDFT.getValue(k) - lExpected).mag() < 1e-9);
+    }
+    // damped
+    fbu::SlidingDFT<double> lDamped(N, lFrequencies, 5, 0.99);
+    lDamped.process(x.data(), x.size());
+    Complexd lExpected = {0., 0.};
+    for (size_t j = 0 ; j != N ; ++j)
+    {
+        lExpected += std::pow(0.99, (double)j) * x[n - j] * Complexd::polar(1., 2. * M_PI * lFrequencies[2] * (double)j);
+    }
+    EXPECT((lDamped.getValue(2) - lExpected).mag() < 1e-9);
+}
+
+CASE("GoertzelBank: matches the DFT of each block")
+{
+    const size_t N = 64;
+    const double lFrequencies[] = {0., 3. / 64., 0.1111, 0.5};
+    std::vector<double> x = randomSignal<double>(3 * N + 10, 2);
+    fbu::GoertzelBank<double> lBank(N, lFrequencies, 4);
+    int lNumBlocks = 0;
+    auto lCheck = [&](const Complexd* pValues, size_t pNumFrequencies) {
+        EXPECT(pNumFrequencies == 4u);
+        const double* lBlock = x.data() + (size_t)lNumBlocks * N;
+        for (size_t k = 0 ; k != pNumFrequencies ; ++k)
+        {
+            Complexd lExpected = {0., 0.};
+            for (size_t n = 0 ; n != N ; ++n)
+            {
+                lExpected += lBlock[n] * Complexd::polar(1., - 2. * M_PI * lFrequencies[k] * (double)n);
+            }
+            EXPECT((pValues[k] - lExpected).mag() < 1e-9);
+        }
+        ++lNumBlocks;
+    };
+    lBank.process(x.data(), 100, lCheck);
+    lBank.process(x.data() + 100, x.size() - 100, lCheck);
+    EXPECT(lNumBlocks == 3);
+    
+    // a tone at a bin center
+    std::vector<float> lTone(256);
+    for (size_t n = 0 ; n != lTone.size() ; ++n)
+    {
+        lTone[n] = std::cos(2.f * M_PIf * 0.125f * (float)n);
+    }
+    const float lToneFrequencies[] = {0.125f, 0.25f};
+    fbu::GoertzelBankf lFloatBank(256, lToneFrequencies, 2);
+    lFloatBank.process(lTone.data(), lTone.size(), [](const Complexf*, size_t) {});
+    EXPECT(lFloatBank.getValues()[0].mag() == lest::approx(128.f));
+    EXPECT(lFloatBank.getValues()[1].mag() < 1e-3f);
+}
@@ -0,0 +1,109 @@
+#include "fbu/spatial_index.hpp"
+
+#include "tests_common.hpp"
+
+#include <random>
+
+namespace
+{
+    std::vector<Vector3f> randomDirections(size_t pNum, unsigned pSeed)
+    {
+        std::mt19937 lRandomGenerator(pSeed);
+        std::normal_distribution<float> lDistribution;
+        std::vector<Vector3f> lDirections(pNum);
+        for (Vector3f& lDir : lDirections)
+        {
+            lDir = Vector3f::cartesian(lDistribution(lRandomGenerator),
+                                       lDistribution(lRandomGenerator),
+                                       lDistribution(lRandomGenerator)).normalized();
+        }
+        return lDirections;
+    }
+}
+
+CASE("KDTree: nearest, k-nearest and radius match brute force")
+{
+    std::vector<Vector3f> lPoints = randomDirections(1000, 1);
+    for (size_t u = 0 ; u != lPoints.size() ; ++u)
+    {
+        lPoints[u] *= 1.f + (float)(u % 7);
+    }
+    fbu::KDTree<float> lTree(lPoints.data(), lPoints.size());
+    std::vector<Vector3f> lQueries = randomDirections(100, 2);
+    for (Vector3f& lQuery : lQueries)
+    {
+        lQuery *= 3.f;
+        std::vector<float> lSqrDistances(lPoints.size());
+        for (size_t u = 0 ; u != lPoints.size() ; ++u)
+        {
+            lSqrDistances[u] = (lPoints[u] - lQuery).sqrLength();
+        }
+        std::vector<float> lSorted(lSqrDistances);
+        std::sort(lSorted.begin(), lSorted.end());
+        
+        EXPECT(lSqrDistances[lTree.nearest(lQuery)] == lSorted[0]);
+        
+        size_t lIndices[5];
+        float lKSqrDistances[5];
+        EXPECT(lTree.kNearest(lQuery, 5, lIndices, lKSqrDistances) == 5u);
+        for (size_t k = 0 ; k != 5 ; ++k)
+        {
+            EXPECT(lKSqrDistances[k] == lSorted[k]);
+            EXPECT(lSqrDistances[lIndices[k]] == lSorted[k]);
+        }
+        
+        std::vector<size_t> lInRadius;
+        lTree.radius(lQuery, 1.5f, lInRadius);
+        size_t lExpectedCount = (size_t)std::count_if(lSorted.begin(), lSorted.end(),
+                                                      [](float d) { return d <= 1.5f * 1.5f; });
+        EXPECT(lInRadius.size() == lExpectedCount);
+    }
+}
+
+CASE("KDTree: empty and small trees")
+{
+    fbu::KDTree<float> lEmpty;
+    EXPECT(lEmpty.nearest(Vector3f::cartesian(1.f, 0.f, 0.f)) == 0u);
+    Vector3f lPoint = Vector3f::cartesian(1.f, 2.f, 3.f);
+    fbu::KDTree<float> lSingle(&lPoint, 1);
+    size_t lIndices[3];
+    float lSqrDistances[3];
+    EXPECT(lSingle.kNearest(Vector3f::cartesian(0.f, 0.f, 0.f), 3, lIndices, lSqrDistances) == 1u);
+    EXPECT(lSqrDistances[0] == lest::approx(14.f));
+}
+
+CASE("DirectionIndex: nearest direction matches brute force")
+{
+    std::vector<Vector3f> lDirections = randomDirections(2000, 3);
+    fbu::DirectionIndex<float> lIndex(lDirections.data(), lDirections.size());
+    std::vector<Vector3f> lQueries = randomDirections(1000, 4);
+    std::vector<size_t> lResults(lQueries.size());
+    lIndex.nearestBatch(lQueries.data(), lQueries.size(), lResults.data());
+    for (size_t q = 0 ; q != lQueries.size() ; ++q)
+    {
+        float lBestDot = -2.f;
+        for (const Vector3f& lDir : lDirections)
+        {
+            lBestDot = std::max(lBestDot, lDir.dot(lQueries[q]));
+        }
+        EXPECT(lDirections[lResults[q]].dot(lQueries[q]) == lBestDot);
+    }
+}
+
+CASE("DirectionIndex: AE queries and angular radius")
+{
+    AEf lSpeakers[4] = {AEf::ae(0.f), AEf::ae(M_PI_2f), AEf::ae(M_PIf), AEf::ae(0.f, M_PI_2f)};
+    fbu::DirectionIndex<float> lIndex(lSpeakers, 4);
+    EXPECT(lIndex.nearest(AEf::ae(0.3f)) == 0u);
+    EXPECT(lIndex.nearest(AEf::ae(1.2f, 0.1f)) == 1u);
+    EXPECT(lIndex.nearest(AEf::ae(-3.f)) == 2u);
+    EXPECT(lIndex.nearest(AEf::ae(0.5f, 1.2f)) == 3u);
+    std::vector<size_t> lWithin;
+    lIndex.withinAngle(Vector3f::cartesian(1.f, 1.f, 0.f), 0.8f, lWithin);
+    EXPECT(lWithin.size() == 2u);
+    size_t lK[2];
+    float lAngles[2];
+    EXPECT(lIndex.kNearest(Vector3f::cartesian(1.f, 0.f, 0.f), 2, lK, lAngles) == 2u);
+    EXPECT(lK[0] == 0u);
+    EXPECT(lAngles[1] == lest::approx(M_PI_2f));
+}
@@ -0,0 +1,83 @@
+#include "fbu/spectrum_analyzer.hpp"
+
+#include "tests_common.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     A sine of pAmplitude at the center of pBin, in blocks of 256 samples.
+     */
+    void pushSine(fbu::SpectrumAnalyzer& pAnalyzer, size_t pBin, float pAmplitude, int pNumBlocks, size_t& pPosition)
+    {
+        std::vector<float> lBlock(256);
+        for (int b = 0 ; b != pNumBlocks ; ++b)
+        {
+            for (float& x : lBlock)
+            {
+                x = pAmplitude * (float)std::sin(2. * M_PI * (double)(pBin * pPosition++) / (double)pAnalyzer.getFFTSize());
+            }
+            pAnalyzer.push(lBlock.data(), (int)lBlock.size());
+        }
+    }
+
+    int findBand(const fbu::SpectrumAnalyzer& pAnalyzer, float pFrequency)
+    {
+        int lBand = 0;
+        while (lBand + 1 < pAnalyzer.getNumBands() && pAnalyzer.getBandFrequency(lBand + 1) < pFrequency)
+        {
+            ++lBand;
+        }
+        return lBand;
+    }
+}
+
+CASE("SpectrumAnalyzer: level of a sine, averaging and peak-hold, inline")
+{
+    fbu::SpectrumAnalyzer lAnalyzer(1024, 48000., 30, nullptr, 0.);
+    EXPECT(lAnalyzer.getNumBands() == 30);
+    EXPECT(lAnalyzer.getBandFrequency(0) > 20.f);
+    EXPECT(!lAnalyzer.update());
+    EXPECT(lAnalyzer.getFrame().mBandsDB[0] == -144.f);
+
+    // bin 64 is 3 kHz
+    lAnalyzer.setAveragingTime(0.f);
+    size_t lPosition = 0;
+    pushSine(lAnalyzer, 64, 1.f, 8, lPosition);
+    EXPECT(lAnalyzer.update());
+    EXPECT(lAnalyzer.getFrame().mFrameIndex == 1u);
+    int lBand = findBand(lAnalyzer, 3000.f);
+    EXPECT(lAnalyzer.getFrame().mBandsDB[(size_t)lBand] == lest::approx(0.f).epsilon(0.01));
+    EXPECT(lAnalyzer.getFrame().mBandsDB[0] < -60.f);
+    // nothing new: no frame
+    EXPECT(!lAnalyzer.update());
+
+    // -20 dB: no averaging, the band drops, the peak falls 20 dB/s
+    pushSine(lAnalyzer, 64, 0.1f, 48, lPosition);
+    EXPECT(lAnalyzer.update());
+    EXPECT(lAnalyzer.getFrame().mBandsDB[(size_t)lBand] == lest::approx(-20.f).epsilon(0.01));
+    EXPECT(lAnalyzer.getFrame().mPeaksDB[(size_t)lBand] == lest::approx(-5.12f).epsilon(0.01));
+}
+
+CASE("SpectrumAnalyzer: frames computed on a ThreadPool, rate limited")
+{
+    fbu::ThreadPool lThreadPool(1);
+    // one frame per 1000 s at most: only the first update schedules a job,
+    // however long the polling takes
+    fbu::SpectrumAnalyzer lAnalyzer(2048, 48000., 20, &lThreadPool, 0.001);
+    size_t lPosition = 0;
+    pushSine(lAnalyzer, 100, 1.f, 20, lPosition);
+    int lNumFrames = 0;
+    for (int i = 0 ; i != 100 && lNumFrames == 0 ; ++i)
+    {
+        lNumFrames += lAnalyzer.update() ? 1 : 0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT(lNumFrames == 1);
+    pushSine(lAnalyzer, 100, 1.f, 20, lPosition);
+    EXPECT(!lAnalyzer.update());
+    EXPECT(lAnalyzer.getFrame().mFrameIndex == 1u);
+    lThreadPool.waitForCompletion();
+}
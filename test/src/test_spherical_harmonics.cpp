@@ -0,0 +1,63 @@
+#include "fbu/spherical_harmonics.hpp"
+
+#include "tests_common.hpp"
+
+CASE("SphericalHarmonics: first and second order SN3D")
+{
+    fbu::SphericalHarmonics<float, 2> lSH;
+    AEf lAE = AEf::ae(0.7f, 0.4f);
+    float lY[9];
+    lSH.evaluate(lAE, lY);
+    float ca = std::cos(lAE.mAzimuth), sa = std::sin(lAE.mAzimuth);
+    float ce = std::cos(lAE.mElevation), se = std::sin(lAE.mElevation);
+    EXPECT(lY[0] == lest::approx(1.f));
+    EXPECT(lY[1] == lest::approx(sa * ce));
+    EXPECT(lY[2] == lest::approx(se));
+    EXPECT(lY[3] == lest::approx(ca * ce));
+    EXPECT(lY[4] == lest::approx(0.5f * M_SQRT3f * std::sin(2.f * lAE.mAzimuth) * ce * ce));
+    EXPECT(lY[5] == lest::approx(0.5f * M_SQRT3f * sa * std::sin(2.f * lAE.mElevation)));
+    EXPECT(lY[6] == lest::approx(0.5f * (3.f * se * se - 1.f)));
+    EXPECT(lY[7] == lest::approx(0.5f * M_SQRT3f * ca * std::sin(2.f * lAE.mElevation)));
+    EXPECT(lY[8] == lest::approx(0.5f * M_SQRT3f * std::cos(2.f * lAE.mAzimuth) * ce * ce));
+}
+
+CASE("SphericalHarmonics: N3D order 7 satisfies the addition theorem")
+{
+    // Sum of Y_n^2 over all harmonics of order l is (2l + 1) in N3D, for any direction
+    fbu::SphericalHarmonics<double, 7> lSH(fbu::SHNormalization::N3D);
+    double lY[64];
+    lSH.evaluate(AEM<double>::aem(-2.1, -0.9, 3.), lY);
+    for (int l = 0 ; l <= 7 ; ++l)
+    {
+        double lSum = 0.;
+        for (int m = -l ; m <= l ; ++m)
+        {
+            lSum += lY[lSH.acn(l, m)] * lY[lSH.acn(l, m)];
+        }
+        EXPECT(lSum == lest::approx(2. * l + 1.));
+    }
+}
+
+CASE("AmbisonicEncoder: multi-source encode accumulates gains x sources")
+{
+    fbu::AmbisonicEncoder<float, 1> lEncoder;
+    const int lNumSamples = 100;
+    std::vector<float> lSourceA(lNumSamples, 1.f);
+    std::vector<float> lSourceB(lNumSamples, 0.5f);
+    const float* lSources[2] = {lSourceA.data(), lSourceB.data()};
+    AEf lDirections[2] = {AEf::ae(0.f), AEf::ae(M_PI_2f)};
+    std::vector<float> lAmbisonic(4 * lNumSamples, 0.f);
+    float* lChannels[4];
+    for (int c = 0 ; c != 4 ; ++c)
+    {
+        lChannels[c] = lAmbisonic.data() + c * lNumSamples;
+    }
+    lEncoder.encode(lSources, lDirections, 2, lChannels, lNumSamples);
+    for (int i = 0 ; i != lNumSamples ; ++i)
+    {
+        EXPECT(lChannels[0][i] == lest::approx(1.5f));
+        EXPECT(lChannels[1][i] == lest::approx(0.5f));
+        EXPECT(lChannels[2][i] + 1.f == lest::approx(1.f));
+        EXPECT(lChannels[3][i] == lest::approx(1.f));
+    }
+}
@@ -0,0 +1,83 @@
+#include "fbu/split_complex.hpp"
+
+#include "tests_common.hpp"
+
+#include <vector>
+
+CASE("SplitComplexBuffer: interleaving round trip")
+{
+    const size_t n = 37;
+    std::vector<Complexf> lIn = randomComplexes<float>(n, 1);
+    fbu::SplitComplexBuffer<float> lBuffer(n);
+    lBuffer.fromInterleaved(lIn.data());
+    EXPECT(lBuffer.re()[3] == lIn[3].re);
+    EXPECT(lBuffer.im()[3] == lIn[3].im);
+    EXPECT(lBuffer.get(36) == lIn[36]);
+    lBuffer.set(0, {2.f, -2.f});
+    std::vector<Complexf> lOut(n);
+    lBuffer.toInterleaved(lOut.data());
+    EXPECT(lOut[0] == Complexf({2.f, -2.f}));
+    for (size_t u = 1 ; u != n ; ++u)
+    {
+        EXPECT(lOut[u] == lIn[u]);
+    }
+}
+
+CASE("SplitComplexBuffer: kernels match Complex arithmetic")
+{
+    const size_t n = 53;
+    std::vector<Complexf> lA = randomComplexes<float>(n, 2);
+    std::vector<Complexf> lB = randomComplexes<float>(n, 3);
+    std::vector<Complexf> lC = randomComplexes<float>(n, 4);
+    fbu::SplitComplexBuffer<float> a(n), b(n), lOut(n), lAcc(n);
+    a.fromInterleaved(lA.data());
+    b.fromInterleaved(lB.data());
+    
+    auto lClose = [](Complexf x, Complexf y) { return (x - y).mag() < 1e-5f; };
+    
+    vectSplitMultiply(a.re(), a.im(), b.re(), b.im(), lOut.re(), lOut.im(), n);
+    for (size_t u = 0 ; u != n ; ++u)
+    {
+        EXPECT(lClose(lOut.get(u), lA[u] * lB[u]));
+    }
+    
+    vectSplitConjMultiply(a.re(), a.im(), b.re(), b.im(), lOut.re(), lOut.im(), n);
+    for (size_t u = 0 ; u != n ; ++u)
+    {
+        EXPECT(lClose(lOut.get(u), lA[u] * lB[u].conj()));
+    }
+    
+    lAcc.fromInterleaved(lC.data());
+    vectSplitMultiplyAccumulate(a.re(), a.im(), b.re(), b.im(), lAcc.re(), lAcc.im(), n);
+    vectSplitConjMultiplyAccumulate(a.re(), a.im(), b.re(), b.im(), lAcc.re(), lAcc.im(), n);
+    for (size_t u = 0 ; u != n ; ++u)
+    {
+        EXPECT(lClose(lAcc.get(u), lC[u] + lA[u] * lB[u] + lA[u] * lB[u].conj()));
+    }
+    
+    // in place
+    lOut.fromInterleaved(lC.data());
+    vectSplitMultiply_I(a.re(), a.im(), lOut.re(), lOut.im(), n);
+    vectSplitConjMultiply_I(b.re(), b.im(), lOut.re(), lOut.im(), n);
+    for (size_t u = 0 ; u != n ; ++u)
+    {
+        EXPECT(lClose(lOut.get(u), lC[u] * lA[u] * lB[u].conj()));
+    }
+    
+    std::vector<float> lMagnitudes(n);
+    vectSplitMagnitude(a.re(), a.im(), lMagnitudes.data(), n);
+    for (size_t u = 0 ; u != n ; ++u)
+    {
+        EXPECT(lMagnitudes[u] == lest::approx(lA[u].mag()));
+    }
+    
+    lAcc.fromInterleaved(lC.data());
+    vectSplitSubtract_I(a.re(), a.im(), lAcc.re(), lAcc.im(), n);
+    vectSplitProductSC_I(0.5f, lAcc.re(), lAcc.im(), n);
+    vectSubtract_I(lA.data(), lC.data(), n);
+    vectProductSC_I(0.5f, lC.data(), n);
+    for (size_t u = 0 ; u != n ; ++u)
+    {
+        EXPECT(lClose(lAcc.get(u), lC[u]));
+    }
+}
@@ -0,0 +1,59 @@
+#include "fbu/spsc_fifo.hpp"
+
+#include "tests_common.hpp"
+
+#include <thread>
+#include <vector>
+
+CASE("SPSCFifo: partial pushes and pops, wrapping around")
+{
+    fbu::SPSCFifo<int> lFifo(5);
+    EXPECT(lFifo.getCapacity() == 8u);
+    int lValues[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    int lOut[10];
+    EXPECT(lFifo.push(lValues, 6) == 6u);
+    EXPECT(lFifo.getNumReady() == 6u);
+    EXPECT(lFifo.pop(lOut, 4) == 4u);
+    EXPECT(lOut[3] == 3);
+    // full: only 6 of the 10 values fit
+    EXPECT(lFifo.push(lValues, 10) == 6u);
+    EXPECT(lFifo.pop(lOut, 10) == 8u);
+    EXPECT(lOut[0] == 4);
+    EXPECT(lOut[1] == 5);
+    EXPECT(lOut[2] == 0);
+    EXPECT(lOut[7] == 5);
+    EXPECT(lFifo.pop(lOut, 10) == 0u);
+}
+
+CASE("SPSCFifo: concurrent producer and consumer keep the order")
+{
+    const int kNumValues = 200000;
+    fbu::SPSCFifo<int> lFifo(64);
+    std::thread lProducer([&lFifo]()
+    {
+        int lNext = 0;
+        int lBlock[7];
+        while (lNext != kNumValues)
+        {
+            int lSize = std::min(7, kNumValues - lNext);
+            for (int i = 0 ; i != lSize ; ++i)
+            {
+                lBlock[i] = lNext + i;
+            }
+            lNext += (int)lFifo.push(lBlock, (size_t)lSize);
+        }
+    });
+    int lExpected = 0;
+    bool lInOrder = true;
+    int lBlock[13];
+    while (lExpected != kNumValues)
+    {
+        size_t lSize = lFifo.pop(lBlock, 13);
+        for (size_t i = 0 ; i != lSize ; ++i)
+        {
+            lInOrder &= lBlock[i] == lExpected++;
+        }
+    }
+    lProducer.join();
+    EXPECT(lInOrder);
+}
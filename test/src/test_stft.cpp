@@ -0,0 +1,74 @@
+#include "fbu/stft.hpp"
+
+#include "tests_common.hpp"
+
+#include <vector>
+
+CASE("STFT: identity processing reconstructs the delayed input")
+{
+    struct Config
+    {
+        size_t mFFTSize;
+        size_t mHopSize;
+        fbu::WindowType mAnalysis;
+        fbu::WindowType mSynthesis;
+    };
+    const Config lConfigs[] = {
+        {256, 64, fbu::WindowType::Hann, fbu::WindowType::Hann},
+        {256, 128, fbu::WindowType::SqrtHann, fbu::WindowType::SqrtHann},
+        {128, 32, fbu::WindowType::BlackmanHarris, fbu::WindowType::Rectangular},
+        {64, 64, fbu::WindowType::Rectangular, fbu::WindowType::Rectangular},
+        {64, 48, fbu::WindowType::Hamming, fbu::WindowType::Hann}
+    };
+    std::vector<float> lSignal = randomSignal<float>(5000, 1);
+    for (const Config& c : lConfigs)
+    {
+        fbu::STFTf lSTFT(c.mFFTSize, c.mHopSize, c.mAnalysis, c.mSynthesis);
+        EXPECT(lSTFT.getNumBins() == c.mFFTSize / 2 + 1);
+        std::vector<float> lOutput = lSignal;
+        size_t lSizes[] = {1, 13, 64, 100, 7, 512};
+        size_t lPosition = 0;
+        int lNumFrames = 0;
+        for (size_t i = 0 ; lPosition != lOutput.size() ; ++i)
+        {
+            size_t n = std::min(lSizes[i % 6], lOutput.size() - lPosition);
+            // in place
+            lSTFT.process(lOutput.data() + lPosition, lOutput.data() + lPosition, n,
+                          [&](Complexf*, size_t) { ++lNumFrames; });
+            lPosition += n;
+        }
+        EXPECT(lNumFrames == (int)(lSignal.size() / c.mHopSize));
+        const size_t lLatency = lSTFT.getLatency();
+        float lMaxError = 0.f;
+        for (size_t n = 0 ; n != lLatency ; ++n)
+        {
+            lMaxError = std::max(lMaxError, std::abs(lOutput[n]));
+        }
+        for (size_t n = lLatency ; n != lSignal.size() ; ++n)
+        {
+            lMaxError = std::max(lMaxError, std::abs(lOutput[n] - lSignal[n - lLatency]));
+        }
+        EXPECT(lMaxError < 1e-4f);
+    }
+}
+
+CASE("STFT: the callback modifies the spectrum")
+{
+    fbu::STFTf lSTFT(128, 32);
+    std::vector<float> lSignal = randomSignal<float>(2000, 2);
+    std::vector<float> lOutput(lSignal.size());
+    lSTFT.process(lSignal.data(), lOutput.data(), lSignal.size(), [](Complexf* pBins, size_t pNumBins) {
+        for (size_t k = 0 ; k != pNumBins ; ++k)
+        {
+            pBins[k] *= 0.5f;
+        }
+    });
+    for (size_t n = lSTFT.getLatency() ; n != lSignal.size() ; ++n)
+    {
+        EXPECT(std::abs(lOutput[n] - 0.5f * lSignal[n - lSTFT.getLatency()]) < 1e-4f);
+    }
+    lSTFT.reset();
+    std::vector<float> lSilence(500, 0.f);
+    lSTFT.process(lSilence.data(), lSilence.data(), lSilence.size(), [](Complexf*, size_t) {});
+    EXPECT(*std::max_element(lSilence.begin(), lSilence.end()) == 0.f);
+}
@@ -0,0 +1,57 @@
+#include "fbu/triple_buffer.hpp"
+
+#include "tests_common.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+CASE("TripleBuffer: the reader gets the latest published value")
+{
+    fbu::TripleBuffer<int> lBuffer(-1);
+    EXPECT(!lBuffer.update());
+    EXPECT(lBuffer.getReadBuffer() == -1);
+    lBuffer.getWriteBuffer() = 1;
+    lBuffer.publish();
+    lBuffer.getWriteBuffer() = 2;
+    lBuffer.publish();
+    EXPECT(lBuffer.update());
+    EXPECT(lBuffer.getReadBuffer() == 2);
+    EXPECT(!lBuffer.update());
+    EXPECT(lBuffer.getReadBuffer() == 2);
+    lBuffer.getWriteBuffer() = 3;
+    lBuffer.publish();
+    EXPECT(lBuffer.update());
+    EXPECT(lBuffer.getReadBuffer() == 3);
+}
+
+CASE("TripleBuffer: concurrent reads see whole, increasing values")
+{
+    const int kNumValues = 100000;
+    fbu::TripleBuffer< std::vector<int> > lBuffer(std::vector<int>(16, 0));
+    std::thread lWriter([&lBuffer]()
+    {
+        for (int i = 1 ; i <= kNumValues ; ++i)
+        {
+            std::vector<int>& lValue = lBuffer.getWriteBuffer();
+            std::fill(lValue.begin(), lValue.end(), i);
+            lBuffer.publish();
+        }
+    });
+    int lLast = 0;
+    bool lConsistent = true;
+    bool lIncreasing = true;
+    while (lLast != kNumValues)
+    {
+        if (lBuffer.update())
+        {
+            const std::vector<int>& lValue = lBuffer.getReadBuffer();
+            lConsistent &= std::all_of(lValue.begin(), lValue.end(), [&lValue](int x) { return x == lValue[0]; });
+            lIncreasing &= lValue[0] > lLast;
+            lLast = lValue[0];
+        }
+    }
+    lWriter.join();
+    EXPECT(lConsistent);
+    EXPECT(lIncreasing);
+}
@@ -0,0 +1,119 @@
+#include "fbu/true_peak.hpp"
+
+#include "tests_common.hpp"
+
+#include "fbu/stopwatch.hpp"
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    std::vector<float> sine(size_t pSize, double pFrequency, double pPhase)
+    {
+        std::vector<float> x(pSize);
+        for (size_t u = 0 ; u != pSize ; ++u)
+        {
+            x[u] = (float)std::sin(2. * M_PI * (pFrequency * (double)u + pPhase));
+        }
+        return x;
+    }
+}
+
+CASE("TruePeakDetector: finds the inter-sample peak of a sine at fs/4")
+{
+    // samples at +/-0.707, true peak of 1 (+3 dB)
+    std::vector<float> x = sine(1000, 0.25, 0.125);
+    for (auto lOversampling : {fbu::TruePeakOversampling::X2, fbu::TruePeakOversampling::X4})
+    {
+        fbu::TruePeakDetector lDetector(1, lOversampling);
+        EXPECT(lDetector.getOversampling() == lOversampling);
+        lDetector.processChannel(0, x.data(), 500);
+        float lPeak = lDetector.processChannel(0, x.data() + 500, 500);
+        EXPECT(lPeak == lest::approx(1.f).epsilon(0.03));
+    }
+}
+
+CASE("TruePeakDetector: under-reading on short blocks, up to 0.4 fs")
+{
+    // blocks of 4 samples: each one holds a crest above fs/4
+    for (auto lOversampling : {fbu::TruePeakOversampling::X2, fbu::TruePeakOversampling::X4})
+    {
+        const double lMaxUnderRead = lOversampling == fbu::TruePeakOversampling::X4 ? 0.45 : 1.7;
+        double lWorst = 0.;
+        double lOver = 0.;
+        for (double f = 0.26 ; f < 0.4 ; f += 0.01)
+        {
+            for (double lPhase = 0. ; lPhase < 1. ; lPhase += 0.05)
+            {
+                std::vector<float> x = sine(64, f, lPhase);
+                fbu::TruePeakDetector lDetector(1, lOversampling);
+                lDetector.processChannel(0, x.data(), 60);
+                double lPeakDB = 20. * std::log10(lDetector.processChannel(0, x.data() + 60, 4));
+                lWorst = std::min(lWorst, lPeakDB);
+                lOver = std::max(lOver, lPeakDB);
+            }
+        }
+        EXPECT(lWorst > -lMaxUnderRead);
+        EXPECT(lOver < 0.25);
+    }
+}
+
+CASE("TruePeakDetector: any block size, independent channels, reset")
+{
+    std::vector<float> lLeft = sine(3000, 0.37, 0.);
+    std::vector<float> lRight = sine(3000, 0.01, 0.);
+    for (float& x : lRight)
+    {
+        x *= 0.5f;
+    }
+    fbu::TruePeakDetector lWhole(2);
+    EXPECT(lWhole.getNumChannels() == 2);
+    const float* lChannels[] = {lLeft.data(), lRight.data()};
+    float lPeaks[2];
+    lWhole.process(lChannels, 3000, lPeaks);
+    EXPECT(lPeaks[1] == lest::approx(0.5f).epsilon(0.01));
+
+    fbu::TruePeakDetector lSplit(2);
+    float lSplitPeaks[2] = {0.f, 0.f};
+    for (int lOffset = 0 ; lOffset < 3000 ; lOffset += 7)
+    {
+        const float* lBlock[] = {lLeft.data() + lOffset, lRight.data() + lOffset};
+        float lBlockPeaks[2];
+        lSplit.process(lBlock, std::min(7, 3000 - lOffset), lBlockPeaks);
+        lSplitPeaks[0] = std::max(lSplitPeaks[0], lBlockPeaks[0]);
+        lSplitPeaks[1] = std::max(lSplitPeaks[1], lBlockPeaks[1]);
+    }
+    EXPECT(lSplitPeaks[0] == lPeaks[0]);
+    EXPECT(lSplitPeaks[1] == lPeaks[1]);
+
+    // no ringing from the previous block after a reset
+    lSplit.reset();
+    std::vector<float> lSilence(20, 0.f);
+    EXPECT(lSplit.processChannel(0, lSilence.data(), 20) == 0.f);
+}
+
+CASE("TruePeakDetector: benchmark" "[.bench]")
+{
+    const int kNumChannels = 64;
+    const int kBlockSize = 512;
+    const int kNumBlocks = 200;
+    std::vector<float> x = sine((size_t)kBlockSize, 0.0123, 0.);
+    std::vector<const float*> lChannels((size_t)kNumChannels, x.data());
+    std::vector<float> lPeaks((size_t)kNumChannels);
+    for (auto lOversampling : {fbu::TruePeakOversampling::X2, fbu::TruePeakOversampling::X4})
+    {
+        fbu::TruePeakDetector lDetector(kNumChannels, lOversampling);
+        StopWatch lSW;
+        lSW.start();
+        for (int b = 0 ; b != kNumBlocks ; ++b)
+        {
+            lDetector.process(lChannels.data(), kBlockSize, lPeaks.data());
+        }
+        lSW.stop();
+        double lNsPerSample = 1e9 * lSW.getSeconds() / ((double)kNumBlocks * kBlockSize * kNumChannels);
+        std::cout << "True peak " << (lOversampling == fbu::TruePeakOversampling::X4 ? "x4" : "x2")
+                  << ": " << lNsPerSample << " ns per sample per channel, "
+                  << 100. * lNsPerSample * 48000. * 1e-9 << "% of a core per channel at 48 kHz" << std::endl;
+    }
+}
@@ -0,0 +1,139 @@
+#include "fbu/vbap.hpp"
+
+#include "tests_common.hpp"
+
+namespace
+{
+    /**
+     Checks that the gains are power-normalized and that the velocity vector
+     points towards the source.
+     */
+    bool panningIsConsistent(const fbu::VBAPf& pVBAP, const std::vector<Vector3f>& pSpeakers, const Vector3f& pDirection)
+    {
+        std::vector<float> lGains((size_t)pVBAP.getNumSpeakers());
+        pVBAP.computeGains(pDirection, lGains.data());
+        float lPower = 0.f;
+        Vector3f lVelocity = Vector3f::cartesian(0.f, 0.f, 0.f);
+        for (size_t i = 0 ; i != lGains.size() ; ++i)
+        {
+            if (lGains[i] < 0.f)
+            {
+                return false;
+            }
+            lPower += lGains[i] * lGains[i];
+            lVelocity += lGains[i] * pSpeakers[i].normalized();
+        }
+        return std::abs(lPower - 1.f) < 0.001f
+            && lVelocity.normalized().dot(pDirection.normalized()) > 0.9999f;
+    }
+}
+
+CASE("VBAP: octahedron")
+{
+    std::vector<Vector3f> lSpeakers = {
+        {1.f, 0.f, 0.f}, {-1.f, 0.f, 0.f}, {0.f, 1.f, 0.f},
+        {0.f, -1.f, 0.f}, {0.f, 0.f, 1.f}, {0.f, 0.f, -1.f}};
+    fbu::VBAPf lVBAP(lSpeakers.data(), (int)lSpeakers.size());
+    EXPECT_NOT(lVBAP.is2D());
+    EXPECT(lVBAP.getNumTriangles() == 8u);
+    EXPECT(lVBAP.getNumVirtualSpeakers() == 6);
+    float lGains[6];
+    lVBAP.computeGains(Vector3f::cartesian(0.f, 1.f, 0.f), lGains);
+    EXPECT(lGains[2] == lest::approx(1.f));
+    EXPECT(lGains[0] + 1.f == lest::approx(1.f));
+    EXPECT(panningIsConsistent(lVBAP, lSpeakers, Vector3f::cartesian(1.f, 1.f, 1.f)));
+    EXPECT(panningIsConsistent(lVBAP, lSpeakers, Vector3f::cartesian(-0.2f, 0.7f, -0.4f)));
+}
+
+CASE("VBAP: cube layout with coplanar faces")
+{
+    std::vector<Vector3f> lSpeakers;
+    for (int i = 0 ; i != 8 ; ++i)
+    {
+        lSpeakers.push_back(Vector3f::cartesian(i & 1 ? 1.f : -1.f, i & 2 ? 1.f : -1.f, i & 4 ? 1.f : -1.f));
+    }
+    fbu::VBAPf lVBAP(lSpeakers.data(), (int)lSpeakers.size());
+    EXPECT(lVBAP.getNumTriangles() == 12u);
+    for (float lAzimuth = -3.f ; lAzimuth < 3.f ; lAzimuth += 0.37f)
+    {
+        for (float lElevation = -1.5f ; lElevation < 1.5f ; lElevation += 0.29f)
+        {
+            EXPECT(panningIsConsistent(lVBAP, lSpeakers, Vector3f::fromAE(AEf::ae(lAzimuth, lElevation))));
+        }
+    }
+}
+
+CASE("VBAP: upper hemisphere layout gets an imaginary speaker below")
+{
+    std::vector<AEf> lLayout;
+    for (int i = 0 ; i != 8 ; ++i)
+    {
+        lLayout.push_back(AEf::ae((float)i * M_PI_4f));
+    }
+    for (int i = 0 ; i != 4 ; ++i)
+    {
+        lLayout.push_back(AEf::ae((float)i * M_PI_2f + M_PI_4f, M_PI_4f));
+    }
+    lLayout.push_back(AEf::ae(0.f, M_PI_2f));
+    fbu::VBAPf lVBAP(lLayout.data(), (int)lLayout.size());
+    EXPECT(lVBAP.getNumVirtualSpeakers() == 14);
+    std::vector<Vector3f> lSpeakers;
+    for (const AEf& lAE : lLayout)
+    {
+        lSpeakers.push_back(Vector3f::fromAE(lAE));
+    }
+    for (float lAzimuth = -3.f ; lAzimuth < 3.f ; lAzimuth += 0.31f)
+    {
+        for (float lElevation = 0.05f ; lElevation < 1.5f ; lElevation += 0.23f)
+        {
+            EXPECT(panningIsConsistent(lVBAP, lSpeakers, Vector3f::fromAE(AEf::ae(lAzimuth, lElevation))));
+        }
+    }
+    // below the horizon, the gains are still power-normalized
+    std::vector<fbu::VBAPf::SparseGains> lSparse(2);
+    AEMf lBelow[2] = {AEMf::aem(0.3f, -0.5f), AEMf::aem(0.f, -M_PI_2f)};
+    lVBAP.computeSparseGainsBatch(lBelow, 2, lSparse.data());
+    for (const fbu::VBAPf::SparseGains& lGains : lSparse)
+    {
+        float lPower = 0.f;
+        for (int v = 0 ; v != lGains.mNumSpeakers ; ++v)
+        {
+            EXPECT(lGains.mSpeakers[v] < 13);
+            lPower += lGains.mGains[v] * lGains.mGains[v];
+        }
+        EXPECT(lPower == lest::approx(1.f));
+    }
+}
+
+CASE("VBAP: horizontal layout uses pairs")
+{
+    AEf lLayout[5] = {AEf::ae(0.f), AEf::ae(0.5f), AEf::ae(-0.5f), AEf::ae(1.9f), AEf::ae(-1.9f)};
+    fbu::VBAPf lVBAP(lLayout, 5);
+    EXPECT(lVBAP.is2D());
+    EXPECT(lVBAP.getNumTriangles() == 5u);
+    float lGains[5];
+    lVBAP.computeGains(AEf::ae(0.25f), lGains);
+    EXPECT(lGains[0] == lest::approx(lGains[1]));
+    EXPECT(lGains[0] == lest::approx(M_SQRT1_2f));
+    std::vector<float> lBatch(10);
+    AEMf lDirections[2] = {AEMf::aem(0.5f), AEMf::aem(M_PIf)};
+    lVBAP.computeGainsBatch(lDirections, 2, lBatch.data());
+    EXPECT(lBatch[1] == lest::approx(1.f));
+    EXPECT(lBatch[5 + 3] == lest::approx(lBatch[5 + 4]));
+}
+
+CASE("VBAP: layout without triangles uses the nearest speaker")
+{
+    AEf lLayout[2] = {AEf::ae(0.f, 0.5f), AEf::ae(2.f, -0.3f)};
+    for (int n = 1 ; n <= 2 ; ++n)
+    {
+        fbu::VBAPf lVBAP(lLayout, n);
+        EXPECT_NOT(lVBAP.is2D());
+        EXPECT((n > 1 || lVBAP.getNumTriangles() == 0u));
+        float lGains[2] = {0.f, 0.f};
+        lVBAP.computeGains(AEf::ae(0.2f, 0.4f), lGains);
+        EXPECT(lGains[0] == lest::approx(1.f));
+        lVBAP.computeGains(AEf::ae(2.1f, -0.2f), lGains);
+        EXPECT(lGains[n - 1] == lest::approx(1.f));
+    }
+}
@@ -0,0 +1,30 @@
+#include "fbu/window.hpp"
+
+#include "tests_common.hpp"
+
+#include <vector>
+
+CASE("Window: periodic windows")
+{
+    const size_t n = 16;
+    std::vector<double> w(n);
+    fbu::fillWindow(fbu::WindowType::Hann, w.data(), n);
+    EXPECT(w[0] == lest::approx(0.));
+    EXPECT(w[n / 2] == lest::approx(1.));
+    // periodic: symmetric around n / 2, and Hann overlap-adds to 1 at 50%
+    for (size_t i = 1 ; i != n / 2 ; ++i)
+    {
+        EXPECT(w[i] == lest::approx(w[n - i]));
+        EXPECT(w[i] + w[i + n / 2] == lest::approx(1.));
+    }
+    fbu::fillWindow(fbu::WindowType::SqrtHann, w.data(), n);
+    EXPECT(w[3] * w[3] + w[3 + n / 2] * w[3 + n / 2] == lest::approx(1.));
+    fbu::fillWindow(fbu::WindowType::Hamming, w.data(), n);
+    EXPECT(w[0] == lest::approx(0.08));
+    fbu::fillWindow(fbu::WindowType::Blackman, w.data(), n);
+    EXPECT(w[n / 2] == lest::approx(1.));
+    fbu::fillWindow(fbu::WindowType::BlackmanHarris, w.data(), n);
+    EXPECT(w[n / 2] == lest::approx(1.));
+    fbu::fillWindow(fbu::WindowType::Rectangular, w.data(), n);
+    EXPECT(w[0] == 1.);
+}
@@ -9,5 +9,43 @@
 
 extern lest::tests & specification();
 
+#include <random>
+#include <vector>
+
+template <typename T>
+struct Complex;
+
+/**
+ Uniform noise in [-1, 1), reproducible from the seed.
+ */
+template <typename T>
+std::vector<T> randomSignal(size_t pSize, unsigned pSeed)
+{
+    std::mt19937 lRandomGenerator(pSeed);
+    std::uniform_real_distribution<T> lDistribution((T)(-1), (T)1);
+    std::vector<T> lSignal(pSize);
+    for (T& x : lSignal)
+    {
+        x = lDistribution(lRandomGenerator);
+    }
+    return lSignal;
+}
+
+/**
+ Complex values with uniform real and imaginary parts in [-1, 1).
+ */
+template <typename T>
+std::vector< Complex<T> > randomComplexes(size_t pSize, unsigned pSeed)
+{
+    std::mt19937 lRandomGenerator(pSeed);
+    std::uniform_real_distribution<T> lDistribution((T)(-1), (T)1);
+    std::vector< Complex<T> > lValues(pSize);
+    for (Complex<T>& c : lValues)
+    {
+        c = {lDistribution(lRandomGenerator), lDistribution(lRandomGenerator)};
+    }
+    return lValues;
+}
+
 #endif
 